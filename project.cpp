@@ -1,544 +1,4384 @@
-//This Project Based on Hotel Management System
-//This Project Facility used Hotel-system(worker)
-//start Boop Micro-Project
-#include<iostream>
-#include<fstream>//for file concept
-#include <string.h>
-
-using namespace std;
-class Base
-{
-	protected:
-		int ch,chh,n,lop,Pay,room,payment;
-		long double Mobile;
-		char gen[5];
-		string name,adhaar,add;			
-		fstream fout;
-
-		
-		void set_Choice()
-		{
-						cout<<"Enter valid Mobile Number +91-->";
-						cin>>Mobile;
-						fout.open("1.txt",ios::app);
-						cout<<"Enter Room Number of Clinte-->";
-						cin>>room;
-						fout<<"Room Number-->"<<room<<endl;
-						cout<<"Enter Name of Client-->";
-						getline(cin,name);
-						fout<<"Name-->"<<name<<endl;
-						cout<<"How many days Book Room?-->";
-						fflush(stdin);
-						cin>>n;
-						fout<<"Book Room-->"<<n<<endl;
-						cout<<"Enter Aadhar Number /xxxx-xxxx-xxxx/->";
-						fflush(stdin);
-						getline(cin,adhaar);
-						fout<<"Adhaar Number-->"<<adhaar<<endl;
-						cout<<"Enter Address-->";
-						fflush(stdin);
-						getline(cin,add);
-						fout<<"address-->"<<add<<endl;
-						cout<<"Enter gender-->";
-						fflush(stdin);
-						cin>>gen;
-						fout<<"Gender-->"<<gen<<endl;		
-						cout<<"Your room fees is->"<<(n*1000);
-						fout<<"payment-->"<<(n*1500)<<endl;			
-						cout<<endl<<"\nHow to pay  this payment\n1.online Payment in mobile-number 2.offline payment on a counter\n-->";
-						fflush(stdin);
-						cin>>Pay;
-						fout<<"-------This Room Detail Is Done.-------"<<endl;
-						cout<<endl;
-							switch(Pay)
-						{
-							case 1:
-							{
-								cout<<"The mobile number of hotel is-+91 9099226684\nPay Room Fees-->";
-								cin>>payment;
-								cout<<endl;
-								cout<<"Payment SucssesFull.!\n"<<endl;
-								cout<<endl;
-								break;
-							}
-							case 2:
-							{	
-								break;				
-							}
-							default:
-							{
-								cout<<"Payment Canceld!\n";	
-							}	
-						}
-						cout<<endl;
-						cout<<"SucssesFully Booked!"<<endl;		
-		}
-		void set_choice()
-		{
-					cout<<"Enter valid Mobile Number +91-->";
-						cin>>Mobile;
-						fout.open("1.txt",ios::app);
-						cout<<"Enter Room Number of Clinte-->";
-						cin>>room;
-						fout<<"Room Number-->"<<room<<endl;
-						cout<<"Enter Name of Client-->";
-						fflush(stdin);
-						getline(cin,name);
-						fout<<"Name-->"<<name<<endl;
-						cout<<"How many days Book Room?-->";
-						fflush(stdin);
-						cin>>n;
-						fout<<"Book Room-->"<<n<<endl;
-						cout<<"Enter Aadhar Number /xxxx-xxxx-xxxx/->";
-						fflush(stdin);
-						getline(cin,adhaar);
-						fout<<"Adhaar Number-->"<<adhaar<<endl;
-						cout<<"Enter Address-->";
-						fflush(stdin);
-						getline(cin,add);
-						fout<<"address-->"<<add<<endl;
-						cout<<"Enter gender-->";
-						fflush(stdin);
-						cin>>gen;
-						fout<<"Gender-->"<<gen<<endl;		
-						cout<<"Your room fees is->"<<(n*1500);
-						fout<<"payment-->"<<(n*1500)<<endl;			
-						cout<<endl<<"\nHow to pay  this payment\n1.online Payment in mobile-number 2.offline payment on a counter\n-->";
-						fflush(stdin);
-						cin>>Pay;
-						fout<<"-------This Room Detail Is Done.-------"<<endl;
-						cout<<endl;
-							switch(Pay)
-						{
-							case 1:
-							{
-								cout<<"The mobile number of hotel is-+91 9099226684\nPay Room Fees-->";
-								cin>>payment;
-								cout<<endl;
-								cout<<"Payment SucssesFull.!\n"<<endl;
-								cout<<endl;
-								break;
-							}
-							case 2:
-							{	
-								break;				
-							}
-							default:
-							{
-								cout<<"Payment Canceld!\n";	
-							}	
-						}
-						cout<<endl;
-						cout<<"SucssesFully Booked!"<<endl;					
-		}
-		void Function_2()
-		{
-			string  user,userChoice; 
-			
-			cout<<"\n1.AC-ROOM or 2.NON-AC Room?";
-			fflush(stdin);
-			cin>>user;
-			cout<<"\n1.Single-Bad or 2.Double-Bad?";
-			fflush(stdin);
-			cin>>userChoice;
-		}
-		void set_3()
-		{
-			int Table,number1;
-			cout<<"How Many Mans For Book Table?-->";
-			cin>>Table;
-			cout<<"\nWhat is Table Number of Client?-->";
-			cin>>number1;
-			cout<<"\nSucssesfully Book Table!!\n";
-		}
-	
-		
-};
-class F_Derived
-{
-	protected:
-			int ch,chh,n,lop,Pay,room,payment,PayMent,N_Days;
-			long double Mobile;
-			char gen[5];
-			string name,add,adhaar;
-			fstream fout;
-			void set_All()
-			{				
-					cout<<"Enter valid Mobile Number +91-->";
-						cin>>Mobile;
-						fout.open("1.txt",ios::app);
-						cout<<"Enter Room Number of Clinte-->";
-						cin>>room;
-						fout<<"Room Number-->"<<room<<endl;
-						cout<<"Enter Name of Client-->";
-						fflush(stdin);
-						getline(cin,name);
-						fout<<"Name-->"<<name<<endl;
-						cout<<"How many days Book Room?-->";
-						fflush(stdin);
-						cin>>n;
-						fout<<"Book Room-->"<<n<<endl;
-						cout<<"Enter Aadhar Number /xxxx-xxxx-xxxx/->";
-						getline(cin,adhaar);
-						fout<<"Adhaar Number-->"<<adhaar<<endl;
-						cout<<"Enter Address-->";
-						fflush(stdin);
-						getline(cin,add);
-						fout<<"address-->"<<add<<endl;
-						cout<<"Enter gender-->";
-						fflush(stdin);
-						cin>>gen;
-						fout<<"Gender-->"<<gen<<endl;		
-						cout<<"Your room fees is->"<<(n*900);
-						fout<<"payment-->"<<(n*1500)<<endl;			
-						cout<<endl<<"\nHow to pay  this payment\n1.online Payment in mobile-number 2.offline payment on a counter\n-->";
-						fflush(stdin);
-						cin>>Pay;
-						fout<<"-------This Room Detail Is Done.-------"<<endl;
-						cout<<endl;
-							switch(Pay)
-						{
-							case 1:
-							{
-								cout<<"The mobile number of hotel is-+91 9099226684\nPay Room Fees-->";
-								cin>>payment;
-								cout<<endl;
-								cout<<"Payment SucssesFull.!\n"<<endl;
-								cout<<endl;
-								break;
-							}
-							case 2:
-							{	
-								break;				
-							}
-							default:
-							{
-								cout<<"Payment Canceld!\n";	
-							}	
-						}
-						cout<<endl;
-						cout<<"SucssesFully Booked!"<<endl;								
-			}			
-					
-		void set_all()
-		{
-				cout<<"Enter valid Mobile Number +91-->";
-						cin>>Mobile;
-						fout.open("1.txt",ios::app);
-						cout<<"Enter Room Number of Clinte-->";
-						cin>>room;
-						fout<<"Room Number-->"<<room<<endl;
-						cout<<"Enter Name of Client-->";
-						fflush(stdin);
-						getline(cin,name);
-						fflush(stdin);
-						fout<<"Name-->"<<name<<endl;
-						cout<<"How many days Book Room?-->";
-						fflush(stdin);
-						cin>>n;
-						fout<<"Book Room-->"<<n<<endl;
-						cout<<"Enter Aadhar Number /xxxx-xxxx-xxxx/->";
-						fflush(stdin);
-						getline(cin,adhaar);
-						fout<<"Adhaar Number-->"<<adhaar<<endl;
-						cout<<"Enter Address-->";
-						fflush(stdin);
-						getline(cin,add);
-						fout<<"address-->"<<add<<endl;
-						cout<<"Enter gender-->";
-						fflush(stdin);
-						cin>>gen;
-						fout<<"Gender-->"<<gen<<endl;		
-						cout<<"Your room fees is->"<<(n*500);
-						fout<<"payment-->"<<(n*1500)<<endl;			
-						cout<<endl<<"\nHow to pay  this payment\n1.online Payment in mobile-number 2.offline payment on a counter\n-->";
-						fflush(stdin);
-						cin>>Pay;
-						fout<<"-------This Room Detail Is Done.-------"<<endl;
-						cout<<endl;
-							switch(Pay)
-						{
-							case 1:
-							{
-								cout<<"The mobile number of hotel is-+91 9099226684\nPay Room Fees-->";
-								cin>>payment;
-								cout<<endl;
-								cout<<"Payment SucssesFull.!\n"<<endl;
-								cout<<endl;
-								break;
-							}
-							case 2:
-							{	
-								break;				
-							}
-							default:
-							{
-								cout<<"Payment Canceld!\n";	
-							}	
-						}
-						cout<<endl;
-						cout<<"SucssesFully Booked!"<<endl;		
-		}
-		void Set_F2()
-		{
-				cout<<"Enter New-Room Number of Clinte-->";
-				fflush(stdin);
-				cin>>room;
-				cout<<"How many days Book Room ??\n-->";
-				fflush(stdin);
-				cin>>n;
-				
-				cout<<endl;
-				cout<<"SucssesFully Booked!"<<endl;	
-		}	
-		Print_set()
-		{
-			
-			ifstream fin;
-			fin.open("1.txt",ios::in);
-			string tp;
-     		while(getline(fin, tp))
-		  { 
-        	 cout << tp << "\n"; 
-    	  }
-	fin.close();
-		}
-			void set_4()
-		{
-			int Room_number,check_out,PAY,LABLE,PayMent,LABEL;
-			string ANY;
-			cout<<"What is Room-Number Before Check out?-->";
-			cin>>Room_number;
-			cout<<"\nBill is Pay or not?\n1.pay2.not-pay\n-->";
-			cin>>PAY;
-			switch(PAY)
-			{
-				case 1:
-					{
-						goto LABLE;		
-					}
-				case 2:
-					{
-						LABEL:
-						cout<<"\nPay Payment";
-						cout<<"\nPay Room-Payment on Counter\n1.Yes or 2.No-->";
-						cin>>PayMent;
-						if(PayMent==1)
-						{
-							cout<<"\nOK Room Payment Is Payed.";
-							LABLE:
-							cout<<"Enter rating for hotel from Client?\n 1-star\n 2-star\n 3-star\n 4-star\n 5-star\n-->";
-							fflush(stdin);
-							cin>>ANY;
-							cout<<"Room is Sucssesfully_check-out.";	
-						}
-						else if(PayMent==2)
-						{
-							cout<<"\nPay-First Room PayMent And After Check Out.";
-							goto LABEL;
-						}
-						else
-						{
-							cout<<"\nSomeThing Error!";	
-						}
-						break;
-					}
-			}
-		
-		}
-};
-class New:public F_Derived,public Base
-{
-	protected:
-		int chh,ch;
-		void set_a()
-		{
-			lop:
-			cout<<"1.Ac Room\n2.Non Ac Room\n-->";
-			cin>>chh;
-			cout<<endl;
-			switch(chh)
-			{
-				case 1:
-					{
-						set_All();
-						break;
-					}
-				case 2:
-					{
-						set_all();
-						break;
-					}
-				default:
-					{
-						cout<<"Incorect case!\n";
-						goto lop;
-					}
-			}
-		}
-			void set_b()
-		{
-			cout<<"1.Ac Room\n2.Non Ac Room\n-->";
-			cin>>chh;
-			cout<<endl;
-			switch(chh)
-			{
-				case 1:
-					{
-						set_choice();
-						break;
-					}
-				case 2:
-					{
-						set_Choice();
-						break;
-					}
-			}
-		}
-			protected:
-		int old;
-		long double mobile;
-		string NAME;
-		
-		void set_6()
-		{
-			exit(0);
-		
-		}
-		void set_2()
-		{
-				cout<<"Enter old Room-Number-->";
-				cin>>old;
-				cout<<"Enter Mobile-Number +91-->";
-				cin>>mobile;
-				cout<<"Enter Any Reson to Change A Room-->";\
-				fflush(stdin);
-				cin>>NAME;
-				Set_F2();//line 133
-				Function_2();//line 281
-				cout<<"SucssesFully Changed Room.!";
-		}	
-		void set_1()
-		{
-			cout<<"1.Single Bad Room\n2.Double Bad Room\n-->";
-			cin>>ch;
-			cout<<endl;
-			switch(ch)
-			{
-				case 1:
-					{
-						set_a();
-						break;
-					}
-				case 2:
-					{
-						set_b();
-						break;
-					}
-			}
-		}
-};
-class Buisness:public New
-{
-	protected:
-		int ch,lable,Main,Mchoice;
-		void PutData()
-		{
-			lable:
-			Main:
-			cout<<"1.Book A Room\n2.Change A Room\n3.Book Table In Resturant\n4.Check Out From Hotel\n5.See Recorde Of Rooms\n6.Exit\n-->";
-			cin>>ch;
-			switch(ch)
-			{
-				case 1:
-					{
-						set_1();//line 420
-						break;
-					}
-				case 2:
-					{
-						set_2();//line 407
-						break;
-				 	}
-				case 3:
-					{
-						set_3();//line 143
-						break;	
-					}
-				case 4:
-					{
-						set_4();//line 305
-						break;
-					}
-				case 5:
-					{
-						Print_set();//line 293
-						break;
-					}
-					case 6:
-					{
-						set_6();//line 402
-						break;
-					}
-				default:
-						cout<<"--------------------------------------"<<endl;
-						cout<<"Invalid Choice Please Re-Enter Choice\n";
-						cout<<"--------------------------------------"<<endl;
-						goto lable;
-			}
-			cout<<"\nEnter 1.For Continue 2. For End -->";
-			cin>>Mchoice;
-			switch(Mchoice)
-			{
-				case 1:
-					{
-						goto Main;
-						break;
-					}
-				case 2:
-					{
-						break;
-					}
-			}	
-		}
-};
-class author:public Buisness//author derived from Buisness
-{
-		protected:
-			int n,user,loop;
-			void get()
-			{
-				cout<<"enter  valid id number-->";
-				cin>>user;
-			}
-			public:
-				author()
-				{
-					loop:
-					get();//line-355
-					n=9636;
-					if(user==n)
-					{
-						cout<<"----------Welcome user--------"<<endl;
-						PutData();
-					}
-					else
-					{
-						cout<<"---------------------------"<<endl;
-						cout<<"Incorect user Id!! Re-Enter"<<endl;
-						cout<<"---------------------------"<<endl;
-						goto loop;
-					}
-			}	
-			~author()
-			{
-				cout<<endl<<"---------------------------"<<endl;
-				cout<<"Sucssesfully work is done.\n"<<endl;
-				cout<<"---------------------------"<<endl;
-			}
-};
-  int main()
-  {		
-	author object1;
-  	return 0;
-  }
+//This Project Based on Hotel Management System
+//This Project Facility used Hotel-system(worker)
+//start Boop Micro-Project
+//build: g++ -std=c++11 -O3 -pthread project.cpp
+#include<iostream>
+#include<fstream>//for file concept
+#include <string.h>
+#include<sstream>
+#include<iomanip>
+#include<vector>
+#include<deque>
+#include<queue>
+#include<map>
+#include<unordered_map>
+#include<unordered_set>
+#include<cstdlib>
+#include<climits>
+#include<ctime>
+#include<string>
+#include<algorithm>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<chrono>
+#include<fcntl.h>
+#include<sys/stat.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include<windows.h>
+#include<io.h>
+#define fsync _commit
+long pwrite(int fd,const void *data,size_t size,long at)
+{
+	_lseek(fd,at,SEEK_SET);
+	return _write(fd,data,size);
+}
+long pread(int fd,void *data,size_t size,long at)
+{
+	_lseek(fd,at,SEEK_SET);
+	return _read(fd,data,size);
+}
+#else
+#include<unistd.h>
+#include<sys/socket.h>
+#include<sys/un.h>
+#include<sys/mman.h>
+#include<signal.h>
+#define O_BINARY 0
+#endif
+
+using namespace std;
+//---------------- Booking store (1.dat) ----------------
+//Fixed-size binary records replace the free-text 1.txt journal.
+//Booking id N lives at HEADER_SIZE+(N-1)*sizeof(Booking_Record),
+//so lookup by id is one seek; a room index gives lookup by room.
+enum Booking_Status { BOOKED=1, CHECKED_OUT=2 };
+
+struct Booking_Record
+{
+	int id;
+	int room;
+	int days;
+	int check_in;		//day number (days since 1970-01-01)
+	int amount;			//room fees for the booked nights
+	int rate;			//average nightly rate of the stay
+	int charges;		//restaurant and other charges posted to the room
+	int pay_mode;		//1 online, 2 counter, 0 cancelled
+	int status;			//Booking_Status
+	int guest;			//Guest_Directory id
+	int moved_on;		//day the stay entered its current room, 0 = never moved
+	int earlier_charge;	//room charge of the nights before moved_on, in earlier rooms
+};
+
+void copy_field(char *dst,const string &src,size_t size)
+{
+	strncpy(dst,src.c_str(),size-1);
+	dst[size-1]='\0';
+}
+string mobile_text(long double Mobile)
+{
+	ostringstream out;
+	out<<fixed<<setprecision(0)<<Mobile;
+	return out.str();
+}
+int today()
+{
+	return (int)(time(NULL)/86400);
+}
+//"YYYY-MM-DD" -> day number, or -1.
+int day_of(const string &date)
+{
+	int y,m,d;
+	char dash1,dash2;
+	istringstream in(date);
+	if(!(in>>y>>dash1>>m>>dash2>>d) || dash1!='-' || dash2!='-' || m<1 || m>12 || d<1 || d>31)
+		return -1;
+	y-=m<=2;
+	int era=(y>=0?y:y-399)/400;
+	int yoe=y-era*400;
+	int doy=(153*(m>2?m-3:m+9)+2)/5+d-1;
+	return era*146097+yoe*365+yoe/4-yoe/100+doy-719468;
+}
+string date_text(int day)
+{
+	int z=day+719468;
+	int era=(z>=0?z:z-146096)/146097;
+	int doe=z-era*146097;
+	int yoe=(doe-doe/1460+doe/36524-doe/146096)/365;
+	int doy=doe-(365*yoe+yoe/4-yoe/100);
+	int mp=(5*doy+2)/153;
+	int d=doy-(153*mp+2)/5+1,m=mp<10?mp+3:mp-9,y=yoe+era*400+(m<=2);
+	ostringstream out;
+	out<<y<<"-"<<setfill('0')<<setw(2)<<m<<"-"<<setw(2)<<d;
+	return out.str();
+}
+
+int lowest_bit(unsigned long long w)
+{
+#ifdef __GNUC__
+	return __builtin_ctzll(w);
+#else
+	int bit=0;
+	while(!(w&1))
+	{
+		w>>=1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+//---------------- Room availability ----------------
+//Each room keeps a per-night bitset (bit d = night base+d is taken),
+//so "is room R free for nights [a,b)" is a few masked word tests.
+//Each room type also keeps, per night, a bitmap of its rooms in room
+//number order; allocate() ORs those of the stay's nights and takes a
+//set bit of the complement, without looking at rooms one by one.
+enum Room_Type { AC_SINGLE=0, AC_DOUBLE=1, NON_AC_SINGLE=2, NON_AC_DOUBLE=3, ROOM_TYPES=4 };
+const char *room_type_name[ROOM_TYPES]={"AC Single-Bad","AC Double-Bad","Non-AC Single-Bad","Non-AC Double-Bad"};
+
+class Room_Calendar
+{
+	protected:
+		typedef unsigned long long Word;
+		int base;							//first night held in the bitsets
+		map<int,int> slot;					//room number -> slot
+		vector<int> number,type;			//per slot
+		vector<vector<Word> > nights;		//per slot
+		vector<int> position;				//per slot: bit in its type's bitmaps
+		vector<int> members[ROOM_TYPES];	//slots of each type by room number
+		vector<vector<Word> > taken[ROOM_TYPES];	//[type][night-base], bit = position
+		int cursor[ROOM_TYPES];				//SPREAD: position the next search starts at
+		int policy;
+		mutex lock;
+
+		//Applies fn to the words covering [a,b) of one slot; a>=base.
+		template<class Fn> bool each_word(int s,int a,int b,Fn fn)
+		{
+			vector<Word> &bits=nights[s];
+			int first=a-base,last=b-base;
+			if((int)bits.size()*64<last)
+				bits.resize((last+63)/64,0);
+			for(int w=first/64;w*64<last;w++)
+			{
+				int lo=w*64>first?0:first-w*64;
+				int hi=(w+1)*64<last?64:last-w*64;
+				Word mask=(hi==64?~0ULL:((1ULL<<hi)-1)) & ~((1ULL<<lo)-1);
+				if(!fn(bits[w],mask))
+					return false;
+			}
+			return true;
+		}
+		static bool clear_in(Word &w,Word mask) { return (w&mask)==0; }
+		static bool set_in(Word &w,Word mask) { w|=mask; return true; }
+		static bool reset_in(Word &w,Word mask) { w&=~mask; return true; }
+		int clamp(int day)
+		{
+			return day<base?base:day;
+		}
+		void mark(int s,int a,int b,bool on)
+		{
+			vector<vector<Word> > &days=taken[type[s]];
+			int words=(members[type[s]].size()+63)/64;
+			Word bit=1ULL<<(position[s]%64);
+			if((int)days.size()<b-base)
+				days.resize(b-base,vector<Word>(words,0));
+			for(int d=a;d<b;d++)
+				if(on)
+					days[d-base][position[s]/64]|=bit;
+				else
+					days[d-base][position[s]/64]&=~bit;
+		}
+		//Rooms of a type free for all of [a,b), word w of the bitmap.
+		Word free_word(int room_type,int a,int b,int w)
+		{
+			const vector<vector<Word> > &days=taken[room_type];
+			int n=members[room_type].size(),left=n-w*64;
+			Word open=left>=64?~0ULL:(1ULL<<left)-1;
+			for(int d=a;d<b && d-base<(int)days.size();d++)
+				open&=~days[d-base][w];
+			return open;
+		}
+		//Sorts each type's rooms by number; run once the rooms are loaded.
+		void index_types()
+		{
+			for(int t=0;t<ROOM_TYPES;t++)
+			{
+				members[t].clear();
+				taken[t].clear();
+				cursor[t]=0;
+			}
+			position.assign(number.size(),0);
+			for(map<int,int>::iterator it=slot.begin();it!=slot.end();++it)
+			{
+				int s=it->second;
+				position[s]=members[type[s]].size();
+				members[type[s]].push_back(s);
+			}
+		}
+	public:
+		enum Allocation { FILL_FLOOR, SPREAD };
+
+		Room_Calendar()
+		{
+			base=today()-today()%64-64;
+			policy=FILL_FLOOR;
+			for(int t=0;t<ROOM_TYPES;t++)
+				cursor[t]=0;
+		}
+		//FILL_FLOOR takes the lowest free room number, keeping guests on
+		//as few floors as possible; SPREAD rotates through the rooms so
+		//they wear evenly.
+		void set_policy(int how)
+		{
+			policy=how;
+		}
+		void add_room(int room,int room_type)
+		{
+			if(slot.count(room))
+				return;
+			slot[room]=number.size();
+			number.push_back(room);
+			type.push_back(room_type);
+			nights.push_back(vector<Word>());
+		}
+		//rooms.txt holds "room type" lines (type 0-3 as Room_Type);
+		//without it floors 1-4 hold 20 rooms of one type each.
+		void load_rooms(const char *path)
+		{
+			ifstream fin(path);
+			int room,room_type;
+			while(fin>>room>>room_type)
+				if(room_type>=0 && room_type<ROOM_TYPES)
+					add_room(room,room_type);
+			if(number.empty())
+				for(int floor=1;floor<=4;floor++)
+					for(int r=1;r<=20;r++)
+						add_room(floor*100+r,floor-1);
+			index_types();
+		}
+		bool exists(int room)
+		{
+			return slot.count(room)!=0;
+		}
+		int type_of(int room)
+		{
+			map<int,int>::iterator it=slot.find(room);
+			return it==slot.end()?-1:type[it->second];
+		}
+		bool is_free(int room,int a,int b)
+		{
+			lock_guard<mutex> guard(lock);
+			map<int,int>::iterator it=slot.find(room);
+			if(it==slot.end())
+				return false;
+			a=clamp(a);
+			return a>=b || each_word(it->second,a,b,clear_in);
+		}
+		int rooms_of(int room_type)
+		{
+			return count(type.begin(),type.end(),room_type);
+		}
+		vector<int> free_rooms(int room_type,int a,int b)
+		{
+			lock_guard<mutex> guard(lock);
+			vector<int> rooms;
+			a=clamp(a);
+			for(size_t s=0;s<number.size();s++)
+				if(type[s]==room_type && (a>=b || each_word(s,a,b,clear_in)))
+					rooms.push_back(number[s]);
+			return rooms;
+		}
+		//Marks [a,b) taken; false (and no change) if any night is taken.
+		bool reserve(int room,int a,int b)
+		{
+			lock_guard<mutex> guard(lock);
+			map<int,int>::iterator it=slot.find(room);
+			if(it==slot.end())
+				return false;
+			a=clamp(a);
+			if(a>=b)
+				return true;
+			if(!each_word(it->second,a,b,clear_in))
+				return false;
+			mark(it->second,a,b,true);
+			return each_word(it->second,a,b,set_in);
+		}
+		void release(int room,int a,int b)
+		{
+			lock_guard<mutex> guard(lock);
+			map<int,int>::iterator it=slot.find(room);
+			a=clamp(a);
+			if(it!=slot.end() && a<b)
+			{
+				each_word(it->second,a,b,reset_in);
+				mark(it->second,a,b,false);
+			}
+		}
+		//Picks a room of the type free for [a,b) by the policy and
+		//reserves it; returns the room number, 0 if none is free.
+		int allocate(int room_type,int a,int b)
+		{
+			lock_guard<mutex> guard(lock);
+			if(room_type<0 || room_type>=ROOM_TYPES || members[room_type].empty())
+				return 0;
+			a=clamp(a);
+			if(a>=b)
+				return 0;
+			int n=members[room_type].size(),words=(n+63)/64,pos=-1;
+			if(policy==SPREAD)
+			{
+				int start=cursor[room_type]%n;
+				for(int i=0;i<=words && pos<0;i++)
+				{
+					int w=(start/64+i)%words;
+					Word open=free_word(room_type,a,b,w);
+					if(i==0)
+						open&=~0ULL<<(start%64);
+					else if(i==words)
+						open&=(1ULL<<(start%64))-1;
+					if(open)
+						pos=w*64+lowest_bit(open);
+				}
+				if(pos>=0)
+					cursor[room_type]=pos+1;
+			}
+			else
+				for(int w=0;w<words && pos<0;w++)
+				{
+					Word open=free_word(room_type,a,b,w);
+					if(open)
+						pos=w*64+lowest_bit(open);
+				}
+			if(pos<0)
+				return 0;
+			int s=members[room_type][pos];
+			mark(s,a,b,true);
+			each_word(s,a,b,set_in);
+			return number[s];
+		}
+};
+Room_Calendar room_calendar;
+
+//---------------- Desk statistics ----------------
+//Counts every desk action and keeps log2 histograms of its end-to-end
+//time and of the persistence time of each journal record it wrote, from
+//handing the record over to the fsync that made it durable. Each
+//thread writes only its own slot, so recording takes no lock; a dump
+//merges the slots.
+enum Desk_Action { ACT_NONE=-1, ACT_BOOK, ACT_CHANGE, ACT_TABLE, ACT_CHECKOUT, ACT_RECORDS, ACT_EXIT, ACT_CHARGE, ACTIONS };
+const char *desk_action_name[ACTIONS]={"book","change","table","checkout","records","exit","charge"};
+
+//Travels with a journal record to the commit that makes it durable.
+struct Persist_Stamp
+{
+	int action;								//desk action that wrote the record
+	chrono::steady_clock::time_point queued;	//when it was handed over
+};
+
+class Desk_Stats
+{
+	public:
+		static const int BUCKETS=40;		//bucket b counts [2^b,2^(b+1)) ns
+		struct Totals
+		{
+			unsigned long long count[ACTIONS],total_ns[ACTIONS],persisted[ACTIONS],persist_ns[ACTIONS];
+			unsigned long long latency[ACTIONS][BUCKETS],persist[ACTIONS][BUCKETS];
+		};
+	protected:
+		struct Thread_Slot
+		{
+			atomic<unsigned long long> count[ACTIONS],total_ns[ACTIONS],persisted[ACTIONS],persist_ns[ACTIONS];
+			atomic<unsigned long long> latency[ACTIONS][BUCKETS],persist[ACTIONS][BUCKETS];
+			int action;						//action running on this thread
+
+			Thread_Slot()
+			{
+				for(int a=0;a<ACTIONS;a++)
+				{
+					count[a]=total_ns[a]=persisted[a]=persist_ns[a]=0;
+					for(int b=0;b<BUCKETS;b++)
+						latency[a][b]=persist[a][b]=0;
+				}
+				action=ACT_NONE;
+			}
+		};
+		struct Slot_Owner
+		{
+			Desk_Stats *stats;
+			Thread_Slot *slot;
+			Slot_Owner(Desk_Stats *owner)
+			{
+				stats=owner;
+				slot=new Thread_Slot;
+				lock_guard<mutex> guard(stats->lock);
+				stats->slots.push_back(slot);
+			}
+			//Folds the slot into the retired totals when the thread ends.
+			~Slot_Owner()
+			{
+				lock_guard<mutex> guard(stats->lock);
+				stats->add(*slot,stats->retired);
+				stats->slots.erase(find(stats->slots.begin(),stats->slots.end(),slot));
+				delete slot;
+			}
+		};
+		mutex lock;					//guards slots and retired
+		vector<Thread_Slot*> slots;
+		Totals retired;
+
+		Thread_Slot &mine()
+		{
+			static thread_local Slot_Owner owner(this);
+			return *owner.slot;
+		}
+		//Only the owning thread writes a slot, so no read-modify-write is needed.
+		static void bump(atomic<unsigned long long> &counter,unsigned long long by)
+		{
+			counter.store(counter.load(memory_order_relaxed)+by,memory_order_relaxed);
+		}
+		static int bucket(unsigned long long ns)
+		{
+			int b=0;
+			while(ns>1 && b<BUCKETS-1)
+			{
+				ns>>=1;
+				b++;
+			}
+			return b;
+		}
+		static void add(Thread_Slot &slot,Totals &out)
+		{
+			for(int a=0;a<ACTIONS;a++)
+			{
+				out.count[a]+=slot.count[a].load(memory_order_relaxed);
+				out.total_ns[a]+=slot.total_ns[a].load(memory_order_relaxed);
+				out.persisted[a]+=slot.persisted[a].load(memory_order_relaxed);
+				out.persist_ns[a]+=slot.persist_ns[a].load(memory_order_relaxed);
+				for(int b=0;b<BUCKETS;b++)
+				{
+					out.latency[a][b]+=slot.latency[a][b].load(memory_order_relaxed);
+					out.persist[a][b]+=slot.persist[a][b].load(memory_order_relaxed);
+				}
+			}
+		}
+		//Upper bound of the bucket holding the p-th fraction of the samples.
+		static unsigned long long percentile(const unsigned long long *hist,unsigned long long count,double p)
+		{
+			unsigned long long seen=0,rank=(unsigned long long)(p*count);
+			for(int b=0;b<BUCKETS;b++)
+				if((seen+=hist[b])>rank)
+					return 2ULL<<b;
+			return 0;
+		}
+	public:
+		Desk_Stats()
+		{
+			memset(&retired,0,sizeof(retired));
+		}
+		void begin(int action)
+		{
+			mine().action=action;
+		}
+		void end(unsigned long long ns)
+		{
+			Thread_Slot &slot=mine();
+			int a=slot.action;
+			if(a==ACT_NONE)
+				return;
+			bump(slot.count[a],1);
+			bump(slot.total_ns[a],ns);
+			bump(slot.latency[a][bucket(ns)],1);
+			slot.action=ACT_NONE;
+		}
+		//For a record this thread hands to a journal now.
+		Persist_Stamp stamp()
+		{
+			Persist_Stamp s;
+			s.action=mine().action;
+			if(s.action!=ACT_NONE)
+				s.queued=chrono::steady_clock::now();
+			return s;
+		}
+		//The record is durable; recorded by whichever thread committed it,
+		//under the action that wrote it.
+		void persisted(const Persist_Stamp &s,chrono::steady_clock::time_point durable)
+		{
+			if(s.action==ACT_NONE)
+				return;
+			Thread_Slot &slot=mine();
+			unsigned long long ns=chrono::duration_cast<chrono::nanoseconds>(durable-s.queued).count();
+			bump(slot.persisted[s.action],1);
+			bump(slot.persist_ns[s.action],ns);
+			bump(slot.persist[s.action][bucket(ns)],1);
+		}
+		void totals(Totals &out)
+		{
+			lock_guard<mutex> guard(lock);
+			out=retired;
+			for(size_t i=0;i<slots.size();i++)
+				add(*slots[i],out);
+		}
+		//Writes the merged counters as one JSON object.
+		bool dump(const char *path)
+		{
+			Totals t;
+			totals(t);
+			ofstream out(path);
+			if(!out)
+				return false;
+			out<<"{\"time\":"<<time(NULL)<<",\"bucket_ns\":\"[2^i,2^(i+1))\",\"actions\":{";
+			for(int a=0;a<ACTIONS;a++)
+			{
+				out<<(a?",":"")<<"\n\""<<desk_action_name[a]<<"\":{\"count\":"<<t.count[a]
+					<<",\"total_ns\":"<<t.total_ns[a]<<",\"persisted\":"<<t.persisted[a]<<",\"persist_ns\":"<<t.persist_ns[a]
+					<<",\"p50_ns\":"<<percentile(t.latency[a],t.count[a],0.5)
+					<<",\"p99_ns\":"<<percentile(t.latency[a],t.count[a],0.99)
+					<<",\"persist_p99_ns\":"<<percentile(t.persist[a],t.persisted[a],0.99);
+				const char *name[2]={"latency","persist"};
+				unsigned long long (*hist[2])[BUCKETS]={t.latency,t.persist};
+				for(int h=0;h<2;h++)
+				{
+					out<<",\""<<name[h]<<"\":[";
+					for(int b=0;b<BUCKETS;b++)
+						out<<(b?",":"")<<hist[h][a][b];
+					out<<"]";
+				}
+				out<<"}";
+			}
+			out<<"}}"<<endl;
+			return (bool)out;
+		}
+};
+Desk_Stats desk_stats;
+const char *stats_path="stats.json";	//set once by --stats; clients can't choose it
+
+//Times one desk action from construction to stop() or destruction.
+class Action_Timer
+{
+	protected:
+		chrono::steady_clock::time_point start;
+		bool running;
+	public:
+		Action_Timer(int action)
+		{
+			desk_stats.begin(action);
+			start=chrono::steady_clock::now();
+			running=true;
+		}
+		~Action_Timer()
+		{
+			stop();
+		}
+		void stop()
+		{
+			if(!running)
+				return;
+			running=false;
+			desk_stats.end(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now()-start).count());
+		}
+};
+
+//---------------- Journal writer ----------------
+//Buffers appended records and commits them in groups, one write and
+//one fsync per group, instead of flushing every field with endl.
+class Journal_Writer
+{
+	public:
+		enum Durability { PER_RECORD, EVERY_N_RECORDS, EVERY_N_MS };
+	protected:
+		int fd;
+		long durable_end;			//bytes already written to the file
+		string pending;				//bytes after durable_end, not yet written
+		int pending_records;
+		bool dirty;					//written since the last fsync
+		Durability mode;
+		int every;
+		vector<Persist_Stamp> waiting;	//records handed over since the last commit
+		mutex lock;
+		condition_variable wake;
+		thread flusher;
+		bool stopping;
+
+		void write_locked()
+		{
+			size_t done=0;
+			while(done<pending.size())
+			{
+				long wrote=pwrite(fd,pending.data()+done,pending.size()-done,durable_end+done);
+				if(wrote<=0)
+					break;
+				done+=wrote;
+			}
+			if(done>0)
+			{
+				durable_end+=done;
+				pending.erase(0,done);
+				dirty=true;
+			}
+		}
+		void commit_locked()
+		{
+			if(!pending.empty() || dirty)
+			{
+				write_locked();
+				if(dirty)
+				{
+					fsync(fd);
+					dirty=false;
+				}
+				pending_records=0;
+			}
+			if(waiting.empty())
+				return;
+			chrono::steady_clock::time_point durable=chrono::steady_clock::now();
+			for(size_t i=0;i<waiting.size();i++)
+				desk_stats.persisted(waiting[i],durable);
+			waiting.clear();
+		}
+		void track_locked(const Persist_Stamp &s)
+		{
+			if(s.action!=ACT_NONE)
+				waiting.push_back(s);
+		}
+		void patch_locked(long at,const void *data,size_t size)
+		{
+			const char *src=(const char*)data;
+			if(at<durable_end)
+			{
+				size_t head=min((long)size,durable_end-at);
+				pwrite(fd,src,head,at);
+				dirty=true;
+				src+=head;
+				at+=head;
+				size-=head;
+			}
+			if(size>0)
+				pending.replace(at-durable_end,size,src,size);
+		}
+		void flush_loop()
+		{
+			unique_lock<mutex> guard(lock);
+			while(!stopping)
+			{
+				wake.wait_for(guard,chrono::milliseconds(every));
+				commit_locked();
+			}
+		}
+		void stop_flusher()
+		{
+			if(!flusher.joinable())
+				return;
+			{
+				lock_guard<mutex> guard(lock);
+				stopping=true;
+			}
+			wake.notify_all();
+			flusher.join();
+		}
+	public:
+		Journal_Writer()
+		{
+			fd=-1;
+			durable_end=0;
+			pending_records=0;
+			dirty=false;
+			mode=PER_RECORD;
+			every=1;
+			stopping=false;
+		}
+		~Journal_Writer()
+		{
+			close();
+		}
+		bool open(const char *path)
+		{
+			fd=::open(path,O_RDWR|O_CREAT|O_BINARY,0644);
+			if(fd<0)
+				return false;
+			durable_end=lseek(fd,0,SEEK_END);
+			return true;
+		}
+		//EVERY_N_RECORDS commits once n records are buffered; EVERY_N_MS
+		//commits from a background thread every n milliseconds.
+		void set_durability(Durability how,int n)
+		{
+			stop_flusher();
+			lock_guard<mutex> guard(lock);
+			commit_locked();
+			mode=how;
+			every=n>0?n:1;
+			stopping=false;
+			if(mode==EVERY_N_MS)
+				flusher=thread(&Journal_Writer::flush_loop,this);
+		}
+		//Returns the file offset the data will be written at.
+		long append(const void *data,size_t size)
+		{
+			Persist_Stamp s=desk_stats.stamp();
+			lock_guard<mutex> guard(lock);
+			long at=durable_end+pending.size();
+			pending.append((const char*)data,size);
+			pending_records++;
+			track_locked(s);
+			if(mode==PER_RECORD || (mode==EVERY_N_RECORDS && pending_records>=every))
+				commit_locked();
+			return at;
+		}
+		//Appends bytes that the next append or overwrite completes; they
+		//are committed with that record instead of on their own.
+		long extend(const void *data,size_t size)
+		{
+			lock_guard<mutex> guard(lock);
+			long at=durable_end+pending.size();
+			pending.append((const char*)data,size);
+			return at;
+		}
+		//Rewrites bytes in place, patching the buffer if they aren't written yet.
+		void overwrite(long at,const void *data,size_t size)
+		{
+			Persist_Stamp s=desk_stats.stamp();
+			lock_guard<mutex> guard(lock);
+			patch_locked(at,data,size);
+			track_locked(s);
+			if(mode==PER_RECORD)
+				commit_locked();
+		}
+		//overwrite() without a commit; settle() accounts for it.
+		void patch(long at,const void *data,size_t size)
+		{
+			lock_guard<mutex> guard(lock);
+			patch_locked(at,data,size);
+		}
+		//Counts records buffered by extend() and patch(), timed from their
+		//stamps, and commits as the durability setting says.
+		void settle(const vector<Persist_Stamp> &records)
+		{
+			lock_guard<mutex> guard(lock);
+			pending_records+=records.size();
+			for(size_t i=0;i<records.size();i++)
+				track_locked(records[i]);
+			if(mode==PER_RECORD || (mode==EVERY_N_RECORDS && pending_records>=every))
+				commit_locked();
+		}
+		bool read(long at,void *data,size_t size)
+		{
+			lock_guard<mutex> guard(lock);
+			char *dst=(char*)data;
+			if(at+(long)size>durable_end+(long)pending.size())
+				return false;
+			if(at<durable_end)
+			{
+				size_t head=min((long)size,durable_end-at);
+				if(pread(fd,dst,head,at)!=(long)head)
+					return false;
+				dst+=head;
+				at+=head;
+				size-=head;
+			}
+			if(size>0)
+				pending.copy(dst,size,at-durable_end);
+			return true;
+		}
+		long end()
+		{
+			lock_guard<mutex> guard(lock);
+			return durable_end+pending.size();
+		}
+		void commit()
+		{
+			lock_guard<mutex> guard(lock);
+			commit_locked();
+		}
+		//Writes the buffered bytes without an fsync, so readers of the file
+		//see them; the next commit syncs them.
+		void write()
+		{
+			lock_guard<mutex> guard(lock);
+			write_locked();
+		}
+		void close()
+		{
+			stop_flusher();
+			if(fd<0)
+				return;
+			commit();
+			::close(fd);
+			fd=-1;
+		}
+};
+
+//---------------- Write-behind queue ----------------
+//Guests, rollups, settlements and table reservations are written by one
+//background thread as well. A desk thread copies the bytes into the
+//queue under a short lock and goes on; the thread takes whatever has
+//queued every couple of milliseconds, applies it to each journal in
+//order and then commits every journal it touched once, as that
+//journal's durability says. Past LIMIT queued bytes producers wait, and
+//anything that reads a journal back calls wait() first.
+class Journal_Queue
+{
+	protected:
+		enum Op { APPEND, EXTEND, OVERWRITE };
+		struct Entry
+		{
+			Journal_Writer *journal;
+			int op;
+			long at;				//OVERWRITE only
+			string bytes;
+			Persist_Stamp stamp;
+		};
+		static const size_t LIMIT=4<<20;
+		deque<Entry> queue;
+		size_t queued;						//bytes in queue
+		unsigned long long pushed,applied;	//entries so far
+		mutex lock;
+		condition_variable wake,drained;
+		thread worker;
+		bool stopping;
+
+		void push(Journal_Writer *journal,int op,long at,const void *data,size_t size)
+		{
+			Persist_Stamp stamp=desk_stats.stamp();
+			unique_lock<mutex> guard(lock);
+			if(!worker.joinable())
+			{
+				stopping=false;
+				worker=thread(&Journal_Queue::run,this);
+			}
+			if(queued>=LIMIT)
+			{
+				wake.notify_one();
+				drained.wait(guard,[&]{ return queued<LIMIT; });
+			}
+			queue.push_back(Entry());
+			Entry &e=queue.back();
+			e.journal=journal;
+			e.op=op;
+			e.at=at;
+			e.bytes.assign((const char*)data,size);
+			e.stamp=stamp;
+			queued+=size;
+			pushed++;
+		}
+		static void apply(deque<Entry> &batch)
+		{
+			map<Journal_Writer*,vector<Persist_Stamp> > records;
+			for(size_t i=0;i<batch.size();i++)
+			{
+				Entry &e=batch[i];
+				if(e.op==OVERWRITE)
+					e.journal->patch(e.at,e.bytes.data(),e.bytes.size());
+				else
+					e.journal->extend(e.bytes.data(),e.bytes.size());
+				vector<Persist_Stamp> &stamps=records[e.journal];
+				if(e.op!=EXTEND)
+					stamps.push_back(e.stamp);
+			}
+			for(map<Journal_Writer*,vector<Persist_Stamp> >::iterator it=records.begin();it!=records.end();++it)
+				it->first->settle(it->second);
+		}
+		void run()
+		{
+			unique_lock<mutex> guard(lock);
+			for(;;)
+			{
+				if(queue.empty())
+				{
+					if(stopping)
+						break;
+					wake.wait_for(guard,chrono::milliseconds(2));
+					continue;
+				}
+				deque<Entry> batch;
+				batch.swap(queue);
+				guard.unlock();
+				apply(batch);
+				guard.lock();
+				queued=0;
+				for(size_t i=0;i<queue.size();i++)
+					queued+=queue[i].bytes.size();
+				applied+=batch.size();
+				drained.notify_all();
+			}
+		}
+	public:
+		Journal_Queue()
+		{
+			queued=0;
+			pushed=applied=0;
+			stopping=false;
+		}
+		~Journal_Queue()
+		{
+			stop();
+		}
+		void append(Journal_Writer *journal,const void *data,size_t size)
+		{
+			push(journal,APPEND,0,data,size);
+		}
+		//See Journal_Writer::extend.
+		void extend(Journal_Writer *journal,const void *data,size_t size)
+		{
+			push(journal,EXTEND,0,data,size);
+		}
+		void overwrite(Journal_Writer *journal,long at,const void *data,size_t size)
+		{
+			push(journal,OVERWRITE,at,data,size);
+		}
+		//Waits until everything queued so far is in its journal and settled.
+		void wait()
+		{
+			unique_lock<mutex> guard(lock);
+			unsigned long long mark=pushed;
+			wake.notify_one();
+			drained.wait(guard,[&]{ return applied>=mark; });
+		}
+		//Drains the queue and ends the thread; a later push starts it again.
+		void stop()
+		{
+			{
+				lock_guard<mutex> guard(lock);
+				if(!worker.joinable())
+					return;
+				stopping=true;
+			}
+			wake.notify_one();
+			worker.join();
+		}
+};
+Journal_Queue journal_queue;
+
+//---------------- Mapped file ----------------
+//Read-only view of a whole file, for bulk loads and the record viewer.
+class Mapped_File
+{
+	protected:
+		const char *base;
+		size_t mapped;
+#ifdef _WIN32
+		HANDLE file,mapping;
+#endif
+	public:
+		Mapped_File()
+		{
+			base=NULL;
+			mapped=0;
+		}
+		~Mapped_File()
+		{
+			unmap();
+		}
+		//False for a missing or empty file.
+		bool map(const char *path)
+		{
+			unmap();
+			struct stat info;
+			if(stat(path,&info)!=0 || info.st_size==0)
+				return false;
+#ifdef _WIN32
+			file=CreateFileA(path,GENERIC_READ,FILE_SHARE_READ|FILE_SHARE_WRITE,NULL,OPEN_EXISTING,0,NULL);
+			mapping=CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+			base=mapping?(const char*)MapViewOfFile(mapping,FILE_MAP_READ,0,0,0):NULL;
+			if(!base)
+			{
+				if(mapping)
+					CloseHandle(mapping);
+				CloseHandle(file);
+			}
+#else
+			int fd=::open(path,O_RDONLY);
+			if(fd<0)
+				return false;
+			void *view=mmap(NULL,info.st_size,PROT_READ,MAP_SHARED,fd,0);
+			::close(fd);
+			base=view==MAP_FAILED?NULL:(const char*)view;
+#endif
+			if(base)
+				mapped=info.st_size;
+			return base!=NULL;
+		}
+		void unmap()
+		{
+			if(!base)
+				return;
+#ifdef _WIN32
+			UnmapViewOfFile(base);
+			CloseHandle(mapping);
+			CloseHandle(file);
+#else
+			munmap((void*)base,mapped);
+#endif
+			base=NULL;
+			mapped=0;
+		}
+		const char *data()
+		{
+			return base;
+		}
+		size_t size()
+		{
+			return mapped;
+		}
+};
+
+//---------------- Guest directory ----------------
+//Each guest is stored once in guests.dat; bookings keep only the guest
+//id. Hash indexes on the normalized mobile number and Aadhaar make
+//registration and repeat-guest lookup O(1).
+struct Guest_Record
+{
+	int id;
+	char mobile[16];		//last 10 digits
+	char adhaar[16];		//digits only
+	char name[40];
+	char address[64];
+	char gender[8];
+};
+
+//What the desk is told about a guest who isn't registered yet.
+struct Guest_Details
+{
+	string mobile,name,adhaar,address,gender;
+};
+
+string digits_of(const string &text)
+{
+	string digits;
+	for(size_t i=0;i<text.size();i++)
+		if(text[i]>='0' && text[i]<='9')
+			digits+=text[i];
+	return digits;
+}
+//Drops separators and the +91 / 0 prefix so every form of a number matches.
+string normalize_mobile(const string &text)
+{
+	string digits=digits_of(text);
+	return digits.size()>10?digits.substr(digits.size()-10):digits;
+}
+
+class Guest_Directory
+{
+	protected:
+		//Guests in memory: numeric keys and offsets into one text arena
+		//instead of the fixed-width on-disk record.
+		struct Guest_Entry
+		{
+			unsigned long long mobile,adhaar;	//key_of(), 0 = none
+			unsigned name,address;				//offsets into text
+			char gender[8];
+		};
+		Journal_Writer journal;
+		vector<Guest_Entry> guests;			//guest id N at N-1
+		string text;						//arena of '\0' terminated names and addresses
+		unordered_map<unsigned long long,int> by_mobile,by_adhaar;
+		mutex lock;
+
+		//Digit strings as numbers; the leading 1 keeps leading zeros significant.
+		static unsigned long long key_of(const string &digits)
+		{
+			return digits.empty()?0:strtoull(("1"+digits.substr(0,15)).c_str(),NULL,10);
+		}
+		static string digits_of_key(unsigned long long key)
+		{
+			ostringstream out;
+			if(key)
+				out<<key;
+			string digits=out.str();
+			return digits.empty()?digits:digits.substr(1);
+		}
+		unsigned keep(const string &value)
+		{
+			unsigned at=text.size();
+			text.append(value.c_str(),value.size()+1);
+			return at;
+		}
+		void add(const Guest_Record &g)
+		{
+			Guest_Entry e;
+			e.mobile=key_of(g.mobile);
+			e.adhaar=key_of(g.adhaar);
+			e.name=keep(g.name);
+			e.address=keep(g.address);
+			memcpy(e.gender,g.gender,sizeof(e.gender));
+			guests.push_back(e);
+			if(e.mobile)
+				by_mobile[e.mobile]=g.id;
+			if(e.adhaar)
+				by_adhaar[e.adhaar]=g.id;
+		}
+		int find_locked(unsigned long long mobile,unsigned long long adhaar)
+		{
+			unordered_map<unsigned long long,int>::iterator it;
+			if(mobile && (it=by_mobile.find(mobile))!=by_mobile.end())
+				return it->second;
+			if(adhaar && (it=by_adhaar.find(adhaar))!=by_adhaar.end())
+				return it->second;
+			return 0;
+		}
+	public:
+		bool open(const char *path)
+		{
+			if(!journal.open(path))
+				return false;
+			Mapped_File file;
+			if(!file.map(path))
+				return true;
+			const Guest_Record *g=(const Guest_Record*)file.data();
+			int n=file.size()/sizeof(Guest_Record);
+			guests.reserve(n);
+			for(int i=0;i<n;i++)
+				add(g[i]);
+			return true;
+		}
+		//Guest id for a mobile number or Aadhaar (any format), or 0.
+		int find(const string &mobile,const string &adhaar)
+		{
+			lock_guard<mutex> guard(lock);
+			return find_locked(key_of(normalize_mobile(mobile)),key_of(digits_of(adhaar)));
+		}
+		//Returns the id of the matching guest, adding the guest if new.
+		int register_guest(const string &mobile,const string &name,const string &adhaar,const string &address,const string &gender)
+		{
+			lock_guard<mutex> guard(lock);
+			string m=normalize_mobile(mobile),a=digits_of(adhaar);
+			int id=find_locked(key_of(m),key_of(a));
+			if(id)
+				return id;
+			Guest_Record g;
+			memset(&g,0,sizeof(g));
+			g.id=guests.size()+1;
+			copy_field(g.mobile,m,sizeof(g.mobile));
+			copy_field(g.adhaar,a,sizeof(g.adhaar));
+			copy_field(g.name,name,sizeof(g.name));
+			copy_field(g.address,address,sizeof(g.address));
+			copy_field(g.gender,gender,sizeof(g.gender));
+			add(g);
+			journal_queue.append(&journal,&g,sizeof(g));
+			return g.id;
+		}
+		int register_guest(const Guest_Details &d)
+		{
+			return register_guest(d.mobile,d.name,d.adhaar,d.address,d.gender);
+		}
+		void set_durability(Journal_Writer::Durability how,int n)
+		{
+			journal.set_durability(how,n);
+		}
+		bool get(int id,Guest_Record &g)
+		{
+			lock_guard<mutex> guard(lock);
+			if(id<1 || id>(int)guests.size())
+				return false;
+			const Guest_Entry &e=guests[id-1];
+			memset(&g,0,sizeof(g));
+			g.id=id;
+			copy_field(g.mobile,digits_of_key(e.mobile),sizeof(g.mobile));
+			copy_field(g.adhaar,digits_of_key(e.adhaar),sizeof(g.adhaar));
+			copy_field(g.name,&text[e.name],sizeof(g.name));
+			copy_field(g.address,&text[e.address],sizeof(g.address));
+			memcpy(g.gender,e.gender,sizeof(g.gender));
+			return true;
+		}
+		string name_of(int id)
+		{
+			lock_guard<mutex> guard(lock);
+			return id>=1 && id<=(int)guests.size()?&text[guests[id-1].name]:"";
+		}
+		//Ids of guests whose name contains part; one pass over the directory.
+		unordered_set<int> named(const string &part)
+		{
+			lock_guard<mutex> guard(lock);
+			unordered_set<int> ids;
+			for(size_t i=0;i<guests.size();i++)
+				if(strstr(&text[guests[i].name],part.c_str()))
+					ids.insert(i+1);
+			return ids;
+		}
+		void close()
+		{
+			journal.close();
+		}
+};
+Guest_Directory guest_directory;
+
+//---------------- Background writer ----------------
+//Desk threads hand booking writes to one writer thread through a ring
+//and go on without touching the disk. The store's lock admits one
+//producer at a time, so the ring is single-producer/single-consumer and
+//needs only the head and tail counters. The writer drains the ring every
+//couple of milliseconds, so a push is a copy and a store with no system
+//call; only a half full ring or a wait() wakes it early, and a full
+//ring makes the producer wait for space.
+struct Booking_Write
+{
+	long at;					//file offset; the end of the file appends
+	Booking_Record rec;
+	Persist_Stamp stamp;
+};
+
+class Booking_Writer
+{
+	protected:
+		static const unsigned RING=1024;		//power of two
+		Booking_Write ring[RING];
+		atomic<unsigned> head,tail;			//next slot to fill, next slot to write
+		Journal_Writer *journal;
+		thread worker;
+		atomic<bool> stopping;
+		mutex lock;							//only for sleeping and waking
+		condition_variable wake,drained;
+
+		void run()
+		{
+			vector<Persist_Stamp> stamps;
+			for(;;)
+			{
+				unsigned t=tail.load(memory_order_relaxed),h=head.load(memory_order_acquire);
+				if(t==h)
+				{
+					if(stopping.load())
+						break;
+					unique_lock<mutex> guard(lock);
+					wake.wait_for(guard,chrono::milliseconds(2));
+					continue;
+				}
+				//One commit for what was drained, as the durability says.
+				stamps.clear();
+				for(unsigned i=t;i!=h;i++)
+				{
+					const Booking_Write &w=ring[i%RING];
+					if(w.at>=journal->end())
+						journal->extend(&w.rec,sizeof(w.rec));
+					else
+						journal->patch(w.at,&w.rec,sizeof(w.rec));
+					stamps.push_back(w.stamp);
+				}
+				journal->settle(stamps);
+				tail.store(h,memory_order_release);
+				lock_guard<mutex> guard(lock);
+				drained.notify_all();
+			}
+		}
+	public:
+		Booking_Writer()
+		{
+			head=tail=0;
+			journal=NULL;
+			stopping=false;
+		}
+		~Booking_Writer()
+		{
+			stop();
+		}
+		void start(Journal_Writer *to)
+		{
+			journal=to;
+			stopping=false;
+			worker=thread(&Booking_Writer::run,this);
+		}
+		void push(long at,const Booking_Record &rec)
+		{
+			unsigned h=head.load(memory_order_relaxed);
+			if(h-tail.load(memory_order_acquire)>=RING)
+			{
+				unique_lock<mutex> guard(lock);
+				drained.wait(guard,[&]{ return h-tail.load(memory_order_acquire)<RING; });
+			}
+			ring[h%RING].at=at;
+			ring[h%RING].rec=rec;
+			ring[h%RING].stamp=desk_stats.stamp();
+			head.store(h+1,memory_order_release);
+			if(h+1-tail.load(memory_order_relaxed)==RING/2)
+				wake.notify_one();
+		}
+		//Waits until every write pushed before the call has reached the journal.
+		void wait()
+		{
+			if(!worker.joinable())
+				return;
+			unique_lock<mutex> guard(lock);
+			unsigned mark=head.load(memory_order_acquire);
+			wake.notify_one();
+			drained.wait(guard,[&]{ return (int)(tail.load(memory_order_acquire)-mark)>=0; });
+		}
+		void stop()
+		{
+			if(!worker.joinable())
+				return;
+			stopping=true;
+			{
+				lock_guard<mutex> guard(lock);
+			}
+			wake.notify_one();
+			worker.join();
+		}
+};
+
+//---------------- Stay table ----------------
+//Open stays as parallel arrays, kept dense by moving the last stay into
+//a freed slot, so a pass over current occupancy reads a few contiguous
+//arrays. Every open stay is BOOKED; a room has at most one.
+class Stay_Table
+{
+	protected:
+		vector<int> id,room,check_in,amount,rate,charges,guest,moved_on,earlier_charge,days;
+		vector<char> pay_mode;
+		unordered_map<int,int> slot_of;		//room -> slot
+
+		void set(int s,const Booking_Record &rec)
+		{
+			id[s]=rec.id;
+			room[s]=rec.room;
+			check_in[s]=rec.check_in;
+			amount[s]=rec.amount;
+			rate[s]=rec.rate;
+			charges[s]=rec.charges;
+			guest[s]=rec.guest;
+			moved_on[s]=rec.moved_on;
+			earlier_charge[s]=rec.earlier_charge;
+			days[s]=rec.days;
+			pay_mode[s]=rec.pay_mode;
+		}
+	public:
+		int size()
+		{
+			return id.size();
+		}
+		void get(int s,Booking_Record &rec)
+		{
+			memset(&rec,0,sizeof(rec));
+			rec.id=id[s];
+			rec.room=room[s];
+			rec.days=days[s];
+			rec.check_in=check_in[s];
+			rec.amount=amount[s];
+			rec.rate=rate[s];
+			rec.charges=charges[s];
+			rec.pay_mode=pay_mode[s];
+			rec.status=BOOKED;
+			rec.guest=guest[s];
+			rec.moved_on=moved_on[s];
+			rec.earlier_charge=earlier_charge[s];
+		}
+		bool find(int r,Booking_Record &rec)
+		{
+			unordered_map<int,int>::iterator it=slot_of.find(r);
+			if(it==slot_of.end())
+				return false;
+			get(it->second,rec);
+			return true;
+		}
+		//Booking id open in room r, or 0.
+		int booking_in(int r)
+		{
+			unordered_map<int,int>::iterator it=slot_of.find(r);
+			return it==slot_of.end()?0:id[it->second];
+		}
+		void put(const Booking_Record &rec)
+		{
+			unordered_map<int,int>::iterator it=slot_of.find(rec.room);
+			if(it!=slot_of.end())
+			{
+				set(it->second,rec);
+				return;
+			}
+			int s=id.size();
+			id.push_back(0);
+			room.push_back(0);
+			check_in.push_back(0);
+			amount.push_back(0);
+			rate.push_back(0);
+			charges.push_back(0);
+			guest.push_back(0);
+			moved_on.push_back(0);
+			earlier_charge.push_back(0);
+			days.push_back(0);
+			pay_mode.push_back(0);
+			set(s,rec);
+			slot_of[rec.room]=s;
+		}
+		bool add_charge(int r,int amount_due,Booking_Record &rec)
+		{
+			unordered_map<int,int>::iterator it=slot_of.find(r);
+			if(it==slot_of.end())
+				return false;
+			charges[it->second]+=amount_due;
+			get(it->second,rec);
+			return true;
+		}
+		void erase(int r)
+		{
+			unordered_map<int,int>::iterator it=slot_of.find(r);
+			if(it==slot_of.end())
+				return;
+			int s=it->second,last=id.size()-1;
+			slot_of.erase(it);
+			if(s!=last)
+			{
+				Booking_Record moved;
+				get(last,moved);
+				set(s,moved);
+				slot_of[moved.room]=s;
+			}
+			id.pop_back();
+			room.pop_back();
+			check_in.pop_back();
+			amount.pop_back();
+			rate.pop_back();
+			charges.pop_back();
+			guest.pop_back();
+			moved_on.pop_back();
+			earlier_charge.pop_back();
+			days.pop_back();
+			pay_mode.pop_back();
+		}
+		void clear()
+		{
+			Stay_Table empty;
+			swap(empty);
+		}
+		void swap(Stay_Table &other)
+		{
+			id.swap(other.id);
+			room.swap(other.room);
+			check_in.swap(other.check_in);
+			amount.swap(other.amount);
+			rate.swap(other.rate);
+			charges.swap(other.charges);
+			guest.swap(other.guest);
+			moved_on.swap(other.moved_on);
+			earlier_charge.swap(other.earlier_charge);
+			days.swap(other.days);
+			pay_mode.swap(other.pay_mode);
+			slot_of.swap(other.slot_of);
+		}
+};
+
+class Booking_Store
+{
+	public:
+		static const long HEADER_SIZE=16;
+		enum History { BY_ROOM, BY_GUEST, BY_DAY, HISTORIES };	//keyed by room, guest id, check-in day
+	protected:
+		static const int MAGIC=0x424c5448;		//"HTLB"
+		static const int VERSION=4;
+		static const int V3_RECORD_SIZE=40;	//version 3 records lack moved_on and earlier_charge
+		Journal_Writer journal;
+		Booking_Writer writer;				//every write after open goes through here
+		int count;
+		map<int,vector<int> > history[HISTORIES];	//key -> booking ids, oldest first
+		Stay_Table active;					//current occupancy
+		recursive_mutex lock;				//guards count and the indexes
+		//A snapshot holds no history, so after a restart from one the
+		//bookings it covers are indexed here by a background pass and
+		//opening the store doesn't wait for them. Read-only once ready.
+		map<int,vector<int> > older[HISTORIES];
+		thread indexer;
+		mutex older_lock;
+		condition_variable older_built;
+		bool older_ready;
+		static const int SNAPSHOT_MAGIC=0x50414e53;	//"SNAP"
+		static const int SNAPSHOT_EVERY=100000;	//new bookings between snapshots
+		string snapshot_path;
+		int snapshot_count;					//bookings covered by the last snapshot
+		thread snapshotter;					//writes the periodic snapshots
+		atomic<bool> snapshotting;
+
+		long offset(int id)
+		{
+			return HEADER_SIZE+(long)(id-1)*sizeof(Booking_Record);
+		}
+		static void add_id(vector<int> &ids,int id)
+		{
+			if(ids.empty() || ids.back()<id)
+				ids.push_back(id);
+			else if(!binary_search(ids.begin(),ids.end(),id))
+				ids.insert(lower_bound(ids.begin(),ids.end(),id),id);
+		}
+		void index(const Booking_Record &rec)
+		{
+			int key[HISTORIES]={rec.room,rec.guest,rec.check_in};
+			for(int h=0;h<HISTORIES;h++)
+				add_id(history[h][key[h]],rec.id);
+			if(rec.status==BOOKED)
+				active.put(rec);
+			else if(active.booking_in(rec.room)==rec.id)
+				active.erase(rec.room);
+		}
+		//Loads the snapshot over the first records of the mapped store and
+		//brings its open stays up to date; those are the only records
+		//rewritten in place. Returns false to replay the whole store.
+		//Older snapshots also hold the room index after the stays; it is ignored.
+		bool load_snapshot(const Booking_Record *rec,int records)
+		{
+			Mapped_File file;
+			if(!file.map(snapshot_path.c_str()) || file.size()<6*sizeof(int))
+				return false;
+			const int *p=(const int*)file.data(),*end=p+file.size()/sizeof(int);
+			if(p[0]!=SNAPSHOT_MAGIC || p[1]!=VERSION || p[2]!=(int)sizeof(Booking_Record) || p[3]>records)
+				return false;
+			int covered=p[3],stays=p[4];
+			p+=6;
+			if(end-p<(long)(stays*sizeof(Booking_Record)/sizeof(int)))
+				return false;
+			const Booking_Record *stay=(const Booking_Record*)p;
+			active.clear();
+			count=covered;
+			for(int i=0;i<stays;i++)
+				if(stay[i].id>=1 && stay[i].id<=covered)
+					index(rec[stay[i].id-1]);
+			return true;
+		}
+		//Rewrites a version 3 store with the wider records; the new fields
+		//start at 0, which is right for stays that were never moved.
+		bool upgrade(const char *path)
+		{
+			string data;
+			{
+				Mapped_File old;
+				if(!old.map(path))
+					return false;
+				int header[4]={MAGIC,VERSION,(int)sizeof(Booking_Record),0};
+				int records=(old.size()-HEADER_SIZE)/V3_RECORD_SIZE;
+				data.append((const char*)header,sizeof(header));
+				Booking_Record rec;
+				for(int i=0;i<records;i++)
+				{
+					memset(&rec,0,sizeof(rec));
+					memcpy(&rec,old.data()+HEADER_SIZE+(size_t)i*V3_RECORD_SIZE,V3_RECORD_SIZE);
+					data.append((const char*)&rec,sizeof(rec));
+				}
+			}
+			string temp=string(path)+".tmp";
+			int fd=::open(temp.c_str(),O_WRONLY|O_CREAT|O_TRUNC|O_BINARY,0644);
+			if(fd<0)
+				return false;
+			size_t done=0;
+			long wrote=0;
+			while(done<data.size() && (wrote=pwrite(fd,data.data()+done,data.size()-done,done))>0)
+				done+=wrote;
+			fsync(fd);
+			::close(fd);
+			journal.close();
+#ifdef _WIN32
+			remove(path);
+#endif
+			if(done<data.size() || rename(temp.c_str(),path)!=0)
+				return false;
+			remove(snapshot_path.c_str());
+			return journal.open(path);
+		}
+		//Indexes bookings 1..covered of the store file into older.
+		void index_older(string path,int covered)
+		{
+			map<int,vector<int> > built[HISTORIES];
+			Mapped_File store;
+			if(store.map(path.c_str()))
+			{
+				const Booking_Record *rec=(const Booking_Record*)(store.data()+HEADER_SIZE);
+				covered=min(covered,(int)((store.size()-HEADER_SIZE)/sizeof(Booking_Record)));
+				for(int id=1;id<=covered;id++)
+				{
+					built[BY_ROOM][rec[id-1].room].push_back(id);
+					built[BY_GUEST][rec[id-1].guest].push_back(id);
+					built[BY_DAY][rec[id-1].check_in].push_back(id);
+				}
+			}
+			lock_guard<mutex> guard(older_lock);
+			for(int h=0;h<HISTORIES;h++)
+				older[h].swap(built[h]);
+			older_ready=true;
+			older_built.notify_all();
+		}
+		//Up to limit ids below cursor, newest first, from the union of the
+		//sorted lists: a merge from the top of each, so the cost follows
+		//the ids returned and the number of lists, not their length.
+		static vector<int> newest(const vector<const vector<int>*> &lists,int cursor,int limit)
+		{
+			typedef pair<int,pair<int,int> > Head;		//id, (list, position)
+			priority_queue<Head> heads;
+			for(size_t i=0;i<lists.size();i++)
+			{
+				const vector<int> &ids=*lists[i];
+				int pos=lower_bound(ids.begin(),ids.end(),cursor)-ids.begin()-1;
+				if(pos>=0)
+					heads.push(Head(ids[pos],make_pair((int)i,pos)));
+			}
+			vector<int> ids;
+			while(!heads.empty() && (int)ids.size()<limit)
+			{
+				Head top=heads.top();
+				heads.pop();
+				if(ids.empty() || ids.back()!=top.first)
+					ids.push_back(top.first);
+				int i=top.second.first,pos=top.second.second-1;
+				if(pos>=0)
+					heads.push(Head((*lists[i])[pos],make_pair(i,pos)));
+			}
+			return ids;
+		}
+
+		void wait_for_older()
+		{
+			unique_lock<mutex> guard(older_lock);
+			older_built.wait(guard,[&]{ return older_ready; });
+		}
+		void write_header()
+		{
+			int header[4]={MAGIC,VERSION,(int)sizeof(Booking_Record),0};
+			journal.append(header,sizeof(header));
+		}
+		//Parses the "Room Number-->" blocks written by the old booking code.
+		//1.txt never recorded check-outs, so imported stays are closed.
+		int import_text(const char *path)
+		{
+			ifstream fin(path);
+			string line;
+			Booking_Record rec;
+			string name,adhaar,address,gender;
+			int imported=0;
+			memset(&rec,0,sizeof(rec));
+			while(getline(fin,line))
+			{
+				if(!line.empty() && line[line.size()-1]=='\r')
+					line.erase(line.size()-1);
+				size_t arrow=line.find("-->");
+				string key=line.substr(0,arrow),value;
+				if(arrow!=string::npos)
+					value=line.substr(arrow+3);
+				if(key=="Room Number")
+					rec.room=atoi(value.c_str());
+				else if(key=="Name")
+					name=value;
+				else if(key=="Book Room")
+					rec.days=atoi(value.c_str());
+				else if(key=="Adhaar Number")
+					adhaar=value;
+				else if(key=="address")
+					address=value;
+				else if(key=="Gender")
+					gender=value;
+				else if(key=="payment")
+				{
+					rec.amount=atoi(value.c_str());
+					rec.rate=rec.days>0?rec.amount/rec.days:rec.amount;
+				}
+				else if(line.find("This Room Detail Is Done")!=string::npos)
+				{
+					rec.pay_mode=2;
+					rec.status=CHECKED_OUT;
+					rec.guest=guest_directory.register_guest("",name,adhaar,address,gender);
+					add(rec);
+					imported++;
+					memset(&rec,0,sizeof(rec));
+				}
+			}
+			return imported;
+		}
+	public:
+		Booking_Store()
+		{
+			count=0;
+			snapshot_count=0;
+			snapshotting=false;
+			older_ready=true;
+		}
+		//Opens (or creates) the store; a new store imports legacy_path once.
+		bool open(const char *path,const char *legacy_path)
+		{
+			if(!journal.open(path))
+				return false;
+			snapshot_path=string(path)+".snap";
+			if(journal.end()==0)
+			{
+				remove(snapshot_path.c_str());
+				write_header();
+				writer.start(&journal);
+				int imported=import_text(legacy_path);
+				commit();
+				if(imported>0)
+					cout<<"Imported "<<imported<<" bookings from "<<legacy_path<<endl;
+				return true;
+			}
+			int header[4];
+			bool readable=journal.read(0,header,sizeof(header));
+			if(readable && header[0]==MAGIC && header[1]==3 && header[2]==V3_RECORD_SIZE)
+			{
+				if(!upgrade(path))
+				{
+					cout<<"Can't upgrade "<<path<<"!"<<endl;
+					return false;
+				}
+				cout<<"Upgraded "<<path<<" to version "<<VERSION<<endl;
+				readable=journal.read(0,header,sizeof(header));
+			}
+			if(!readable || header[0]!=MAGIC || header[1]!=VERSION || header[2]!=(int)sizeof(Booking_Record))
+			{
+				cout<<path<<" is not a booking store!"<<endl;
+				journal.close();
+				return false;
+			}
+			Mapped_File store;
+			if(!store.map(path))
+				return false;
+			int records=(store.size()-HEADER_SIZE)/sizeof(Booking_Record);
+			const Booking_Record *rec=(const Booking_Record*)(store.data()+HEADER_SIZE);
+			int covered=0;
+			if(load_snapshot(rec,records))
+			{
+				covered=count;
+				cout<<"Recovered "<<count<<" bookings from "<<snapshot_path<<", replaying "<<records-count<<endl;
+			}
+			while(count<records)
+				index(rec[count++]);
+			snapshot_count=count;
+			if(covered>0)
+			{
+				older_ready=false;
+				indexer=thread(&Booking_Store::index_older,this,string(path),covered);
+			}
+			writer.start(&journal);
+			return true;
+		}
+		//count and the open stays, the live state; history is read back
+		//from the store. At most one stay per room, so the size is bounded
+		//by the hotel rather than by its history. The caller holds lock.
+		string snapshot_data()
+		{
+			string data;
+			int header[6]={SNAPSHOT_MAGIC,VERSION,(int)sizeof(Booking_Record),count,(int)active.size(),0};
+			data.append((const char*)header,sizeof(header));
+			Booking_Record stay;
+			for(int s=0;s<active.size();s++)
+			{
+				active.get(s,stay);
+				data.append((const char*)&stay,sizeof(stay));
+			}
+			return data;
+		}
+		//Writes a snapshot of the first covered bookings to a temporary
+		//file, once those bookings are on disk, and renames it over the
+		//old snapshot, so a crash leaves one complete snapshot or the other.
+		bool write_snapshot(const string &data,int covered)
+		{
+			commit();
+			string temp=snapshot_path+".tmp";
+			int fd=::open(temp.c_str(),O_WRONLY|O_CREAT|O_TRUNC|O_BINARY,0644);
+			if(fd<0)
+				return false;
+			size_t done=0;
+			long wrote=0;
+			while(done<data.size() && (wrote=pwrite(fd,data.data()+done,data.size()-done,done))>0)
+				done+=wrote;
+			fsync(fd);
+			::close(fd);
+#ifdef _WIN32
+			remove(snapshot_path.c_str());
+#endif
+			if(done<data.size() || rename(temp.c_str(),snapshot_path.c_str())!=0)
+				return false;
+			lock_guard<recursive_mutex> guard(lock);
+			snapshot_count=max(snapshot_count,covered);
+			return true;
+		}
+		void background_snapshot()
+		{
+			snapshot();
+			snapshotting=false;
+		}
+		bool snapshot()
+		{
+			string data;
+			int covered;
+			{
+				lock_guard<recursive_mutex> guard(lock);
+				data=snapshot_data();
+				covered=count;
+			}
+			return write_snapshot(data,covered);
+		}
+		void set_durability(Journal_Writer::Durability how,int n)
+		{
+			journal.set_durability(how,n);
+		}
+		void close()
+		{
+			if(indexer.joinable())
+				indexer.join();
+			if(snapshotter.joinable())
+				snapshotter.join();
+			if(!snapshot_path.empty() && count>snapshot_count)
+				snapshot();
+			writer.stop();
+			journal.close();
+		}
+		//Blocks until every booking written so far is on disk; for the
+		//viewer, snapshots and exit, never on the booking path.
+		void commit()
+		{
+			writer.wait();
+			journal.commit();
+		}
+		int add(Booking_Record &rec)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			rec.id=++count;
+			writer.push(offset(rec.id),rec);
+			index(rec);
+			//The snapshot thread copies the open stays and writes the file.
+			if(count-snapshot_count>=SNAPSHOT_EVERY && !snapshotting.exchange(true))
+			{
+				if(snapshotter.joinable())
+					snapshotter.join();
+				snapshotter=thread(&Booking_Store::background_snapshot,this);
+			}
+			return rec.id;
+		}
+		bool get(int id,Booking_Record &rec)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			if(id<1 || id>count)
+				return false;
+			writer.wait();
+			return journal.read(offset(id),&rec,sizeof(rec));
+		}
+		//O(1): open stays are held in memory, no disk read.
+		bool find_active(int room,Booking_Record &rec)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			return active.find(room,rec);
+		}
+		//Up to limit booking ids below cursor, newest first, of the bookings
+		//indexed under any of keys (BY_ROOM, BY_GUEST) or under a key in
+		//lo..hi. A booking is indexed under every room it has been in.
+		//Waits for the background pass the first time after a restart.
+		vector<int> newest_of(int h,const vector<int> &keys,int cursor,int limit)
+		{
+			wait_for_older();
+			lock_guard<recursive_mutex> guard(lock);
+			vector<const vector<int>*> lists;
+			for(size_t k=0;k<keys.size();k++)
+			{
+				map<int,vector<int> >::const_iterator it=history[h].find(keys[k]);
+				if(it!=history[h].end())
+					lists.push_back(&it->second);
+				if((it=older[h].find(keys[k]))!=older[h].end())
+					lists.push_back(&it->second);
+			}
+			return newest(lists,cursor,limit);
+		}
+		vector<int> newest_between(int h,int lo,int hi,int cursor,int limit)
+		{
+			wait_for_older();
+			lock_guard<recursive_mutex> guard(lock);
+			vector<int> keys;
+			for(int o=0;o<2;o++)
+			{
+				map<int,vector<int> > &m=o?older[h]:history[h];
+				for(map<int,vector<int> >::iterator it=m.lower_bound(lo);it!=m.end() && it->first<=hi;++it)
+					keys.push_back(it->first);
+			}
+			sort(keys.begin(),keys.end());
+			keys.erase(unique(keys.begin(),keys.end()),keys.end());
+			return newest_of(h,keys,cursor,limit);
+		}
+		//Hands every booking written so far to the file, without an fsync,
+		//so a reader mapping the file sees them.
+		void publish()
+		{
+			writer.wait();
+			journal.write();
+		}
+		vector<Booking_Record> open_stays()
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			vector<Booking_Record> stays(active.size());
+			for(int s=0;s<active.size();s++)
+				active.get(s,stays[s]);
+			return stays;
+		}
+		int size()
+		{
+			return count;
+		}
+		//Moves the open booking of old_room to new_room, staying days more
+		//nights; earlier_charge prices the nights spent before today. False
+		//if new_room already has an open booking: a room holds one stay.
+		bool move(int old_room,int new_room,int days,int earlier_charge)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			Booking_Record rec;
+			if(!find_active(old_room,rec) || active.booking_in(new_room))
+				return false;
+			rec.room=new_room;
+			rec.days=today()-rec.check_in+days;
+			rec.moved_on=today();
+			rec.earlier_charge=earlier_charge;
+			writer.push(offset(rec.id),rec);
+			active.erase(old_room);
+			index(rec);
+			return true;
+		}
+		//Adds a charge to the open booking of a room.
+		bool post_charge(int room,int amount)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			Booking_Record rec;
+			if(!active.add_charge(room,amount,rec))
+				return false;
+			writer.push(offset(rec.id),rec);
+			return true;
+		}
+		//Closes the open booking of a room in place; rec gets the closed stay.
+		bool checkout(int room,Booking_Record &rec)
+		{
+			lock_guard<recursive_mutex> guard(lock);
+			if(!find_active(room,rec))
+				return false;
+			room_calendar.release(room,today(),rec.check_in+rec.days);
+			rec.status=CHECKED_OUT;
+			writer.push(offset(rec.id),rec);
+			active.erase(room);
+			return true;
+		}
+		void print(const Booking_Record &rec)
+		{
+			cout<<"Booking Id-->"<<rec.id<<endl;
+			cout<<"Room Number-->"<<rec.room<<endl;
+			Guest_Record g;
+			memset(&g,0,sizeof(g));
+			guest_directory.get(rec.guest,g);
+			cout<<"Guest Id-->"<<rec.guest<<endl;
+			cout<<"Name-->"<<g.name<<endl;
+			cout<<"Mobile-->"<<g.mobile<<endl;
+			cout<<"Check-In-->"<<date_text(rec.check_in)<<endl;
+			cout<<"Book Room-->"<<rec.days<<endl;
+			cout<<"Adhaar Number-->"<<g.adhaar<<endl;
+			cout<<"address-->"<<g.address<<endl;
+			cout<<"Gender-->"<<g.gender<<endl;
+			cout<<"payment-->"<<rec.amount<<endl;
+			if(rec.charges)
+				cout<<"Other Charges-->"<<rec.charges<<endl;
+			cout<<"Status-->"<<(rec.status==BOOKED?"Booked":"Checked-out")<<endl;
+			cout<<"-------This Room Detail Is Done.-------"<<endl;
+		}
+};
+Booking_Store booking_store;
+
+//---------------- Booking viewer ----------------
+//Pages through 1.dat newest first through a read-only memory map, so
+//the first page of a query only touches the records it shows. A filter
+//on room, guest name or dates reads only the bookings the store's room,
+//guest or check-in day index offers for it.
+struct Booking_Filter
+{
+	int room;			//0 = any
+	string name;		//substring, "" = any
+	unordered_set<int> guests;	//guests matching name, see use_name()
+	int from_day,to_day;	//check-in range, inclusive; -1 = open
+	int pay_mode;		//-1 = any, 0 cancelled, 1 online, 2 counter
+
+	Booking_Filter()
+	{
+		room=0;
+		from_day=to_day=-1;
+		pay_mode=-1;
+	}
+	bool match(const Booking_Record &rec) const
+	{
+		return (room==0 || rec.room==room)
+			&& (from_day<0 || rec.check_in>=from_day)
+			&& (to_day<0 || rec.check_in<=to_day)
+			&& (pay_mode<0 || rec.pay_mode==pay_mode)
+			&& (name.empty() || guests.count(rec.guest));
+	}
+	void use_name(const string &part)
+	{
+		name=part;
+		guests=guest_directory.named(part);
+	}
+};
+
+class Booking_Viewer
+{
+	protected:
+		string path;
+		Mapped_File view;
+
+		static const int BATCH=256;		//ids asked of an index at a time
+
+		//Maps the whole file again if it has grown since the last query.
+		bool refresh()
+		{
+			booking_store.publish();
+			struct stat info;
+			if(stat(path.c_str(),&info)!=0)
+				return false;
+			if(view.data() && (size_t)info.st_size==view.size())
+				return true;
+			view.unmap();
+			if(info.st_size<=Booking_Store::HEADER_SIZE)
+				return true;
+			return view.map(path.c_str());
+		}
+		int records()
+		{
+			return view.data()?(view.size()-Booking_Store::HEADER_SIZE)/sizeof(Booking_Record):0;
+		}
+		const Booking_Record *record(int id)
+		{
+			return (const Booking_Record*)(view.data()+Booking_Store::HEADER_SIZE+(size_t)(id-1)*sizeof(Booking_Record));
+		}
+		//Room first, as it has the shortest history, then guests, then dates.
+		vector<int> candidates(const Booking_Filter &filter,const vector<int> &guests,int cursor)
+		{
+			if(filter.room)
+				return booking_store.newest_of(Booking_Store::BY_ROOM,vector<int>(1,filter.room),cursor,BATCH);
+			if(!filter.name.empty())
+				return booking_store.newest_of(Booking_Store::BY_GUEST,guests,cursor,BATCH);
+			return booking_store.newest_between(Booking_Store::BY_DAY,filter.from_day<0?INT_MIN:filter.from_day,
+				filter.to_day<0?INT_MAX:filter.to_day,cursor,BATCH);
+		}
+	public:
+		Booking_Viewer(const string &file_path)
+		{
+			path=file_path;
+		}
+		//Fills out with up to page_size matches older than cursor (0 = newest)
+		//and returns the cursor for the next page, 0 when nothing is left.
+		int page(const Booking_Filter &filter,int cursor,int page_size,vector<const Booking_Record*> &out)
+		{
+			out.clear();
+			if(!refresh())
+				return 0;
+			int last=records();
+			if(cursor<=0 || cursor>last+1)
+				cursor=last+1;
+			if(filter.room || !filter.name.empty() || filter.from_day>=0 || filter.to_day>=0)
+			{
+				vector<int> guests(filter.guests.begin(),filter.guests.end());
+				for(;;)
+				{
+					vector<int> ids=candidates(filter,guests,cursor);
+					for(size_t i=0;i<ids.size();i++)
+						if(ids[i]<=last && filter.match(*record(ids[i])))
+						{
+							out.push_back(record(ids[i]));
+							if((int)out.size()==page_size)
+								return ids[i];
+						}
+					if((int)ids.size()<BATCH)
+						return 0;
+					cursor=ids.back();
+				}
+			}
+			int id=cursor;
+			while(--id>=1 && (int)out.size()<page_size)
+				if(filter.match(*record(id)))
+					out.push_back(record(id));
+			return id>=1?id+1:0;
+		}
+};
+
+//Puts every open stay of the store on the room calendar.
+void load_calendar()
+{
+	room_calendar.load_rooms("rooms.txt");
+	vector<Booking_Record> stays=booking_store.open_stays();
+	for(size_t i=0;i<stays.size();i++)
+		room_calendar.reserve(stays[i].room,stays[i].check_in,stays[i].check_in+stays[i].days);
+}
+
+//---------------- Tariffs ----------------
+//Room and bed types are compile-time policies; the nightly tariff of a
+//combination is a constant, so the folio is one multiply and the fee
+//shown to the guest is the fee written to the booking.
+struct Ac_Room { static const int index=0; };
+struct Non_Ac_Room { static const int index=1; };
+struct Single_Bed { static const int index=0; };
+struct Double_Bed { static const int index=1; };
+
+constexpr int room_tariff[2][2]={{900,1500},{500,1000}};	//[room][bed], per night
+
+template<class Room,class Bed> struct Tariff
+{
+	static constexpr int per_night=room_tariff[Room::index][Bed::index];
+	static constexpr int room_type=Room::index*2+Bed::index;		//matches Room_Type
+	static int folio(int nights)
+	{
+		return nights*per_night;
+	}
+};
+constexpr int nightly_tariff(int room_type)
+{
+	return room_tariff[room_type/2][room_type%2];
+}
+
+//---------------- Rate calendar ----------------
+//Nightly rate of every room type for each day of a window around today,
+//one dense array per type, so a stay's price is a straight sum over a
+//slice that the compiler vectorizes. rates.txt lines, later lines win:
+//  <type|*> weekend <rate>                  Friday and Saturday nights
+//  <type|*> YYYY-MM-DD YYYY-MM-DD <rate>    nights from..to, inclusive
+//Nights outside the window get the tariff or the weekend rate.
+class Rate_Calendar
+{
+	protected:
+		static const int PAST=400,AHEAD=800;	//days kept around today
+		int base;								//first day in the arrays
+		vector<int> rate[ROOM_TYPES];
+		int weekend[ROOM_TYPES];				//0 = no weekend rate
+
+		static bool is_weekend(int day)
+		{
+			int weekday=((day%7)+11)%7;			//day 0, 1970-01-01, was a Thursday
+			return weekday==5 || weekday==6;
+		}
+		int fallback(int room_type,int day)
+		{
+			return weekend[room_type] && is_weekend(day)?weekend[room_type]:nightly_tariff(room_type);
+		}
+		void set_weekend(int room_type,int amount)
+		{
+			weekend[room_type]=amount;
+			for(size_t i=0;i<rate[room_type].size();i++)
+				if(is_weekend(base+i))
+					rate[room_type][i]=amount;
+		}
+		void set_range(int room_type,int a,int b,int amount)
+		{
+			a=max(a,base);
+			b=min(b,base+(int)rate[room_type].size()-1);
+			for(int d=a;d<=b;d++)
+				rate[room_type][d-base]=amount;
+		}
+	public:
+		Rate_Calendar()
+		{
+			base=today()-PAST;
+			for(int t=0;t<ROOM_TYPES;t++)
+			{
+				rate[t].assign(PAST+AHEAD,nightly_tariff(t));
+				weekend[t]=0;
+			}
+		}
+		void load_rates(const char *path)
+		{
+			ifstream fin(path);
+			string line;
+			while(getline(fin,line))
+			{
+				istringstream in(line);
+				string type,from,to;
+				int first=0,last=ROOM_TYPES-1,amount=0;
+				if(line.empty() || line[0]=='#' || !(in>>type>>from))
+					continue;
+				if(type!="*")
+				{
+					first=last=atoi(type.c_str());
+					if(type.find_first_not_of("0123456789")!=string::npos || first>=ROOM_TYPES)
+						continue;
+				}
+				if(from=="weekend")
+				{
+					if(in>>amount && amount>0)
+						for(int t=first;t<=last;t++)
+							set_weekend(t,amount);
+				}
+				else if(in>>to>>amount && amount>0 && day_of(from)>=0 && day_of(to)>=day_of(from))
+					for(int t=first;t<=last;t++)
+						set_range(t,day_of(from),day_of(to),amount);
+			}
+		}
+		int rate_of(int room_type,int day)
+		{
+			if(day>=base && day<base+(int)rate[room_type].size())
+				return rate[room_type][day-base];
+			return fallback(room_type,day);
+		}
+		//Price of the nights a..a+nights-1.
+		int quote(int room_type,int a,int nights)
+		{
+			if(room_type<0 || room_type>=ROOM_TYPES || nights<=0)
+				return 0;
+			int b=a+nights,end=base+(int)rate[room_type].size();
+			int lo=max(a,base),hi=min(b,end),total=0;
+			const int *r=&rate[room_type][0];
+			for(int i=lo-base;i<hi-base;i++)
+				total+=r[i];
+			for(int d=a;d<min(b,base);d++)
+				total+=fallback(room_type,d);
+			for(int d=max(a,end);d<b;d++)
+				total+=fallback(room_type,d);
+			return total;
+		}
+		void quote_all(int a,int nights,int out[ROOM_TYPES])
+		{
+			for(int t=0;t<ROOM_TYPES;t++)
+				out[t]=quote(t,a,nights);
+		}
+};
+Rate_Calendar rate_calendar;
+
+//---------------- Folio settlement ----------------
+//One record per checkout, appended to settle.dat.
+struct Settlement_Record
+{
+	int booking_id;
+	int room;
+	int day;			//checkout day number
+	int nights;
+	int rate;
+	int room_charge;	//nights*rate
+	int charges;		//restaurant and other posted charges
+	int total;
+	int pay_mode;		//1 online, 2 counter
+};
+
+class Folio_Ledger
+{
+	protected:
+		Journal_Writer journal;
+	public:
+		bool open(const char *path)
+		{
+			return journal.open(path);
+		}
+		void append(const Settlement_Record &bill)
+		{
+			journal_queue.append(&journal,&bill,sizeof(bill));
+		}
+		//n-th settlement from 0.
+		bool read(int n,Settlement_Record &bill)
+		{
+			journal_queue.wait();
+			return journal.read((long)n*sizeof(bill),&bill,sizeof(bill));
+		}
+		void close()
+		{
+			journal.close();
+		}
+};
+Folio_Ledger folio_ledger;
+
+//Room charge of the stay's nights before day; nights before a room
+//change keep the price of the room they were spent in.
+int room_charge_until(const Booking_Record &stay,int day)
+{
+	int from=stay.moved_on>stay.check_in?stay.moved_on:stay.check_in;
+	int earlier=stay.moved_on>stay.check_in?stay.earlier_charge:0;
+	return earlier+rate_calendar.quote(room_calendar.type_of(stay.room),from,day-from);
+}
+//Nights stayed so far (at least one) at the booked rate plus posted charges.
+void make_folio(const Booking_Record &stay,int pay_mode,Settlement_Record &bill)
+{
+	bill.booking_id=stay.id;
+	bill.room=stay.room;
+	bill.day=today();
+	bill.nights=max(1,bill.day-stay.check_in);
+	bill.room_charge=room_charge_until(stay,stay.check_in+bill.nights);
+	bill.rate=bill.room_charge/bill.nights;
+	bill.charges=stay.charges;
+	bill.total=bill.room_charge+bill.charges;
+	bill.pay_mode=pay_mode;
+}
+void print_folio(const Settlement_Record &bill)
+{
+	cout<<"\n-------Bill Of Room "<<bill.room<<"-------"<<endl;
+	cout<<"Nights-->"<<bill.nights<<" = "<<bill.room_charge<<" (avg "<<bill.rate<<" per night)"<<endl;
+	cout<<"Resturant/Other-->"<<bill.charges<<endl;
+	cout<<"Total-->"<<bill.total<<endl;
+}
+
+//---------------- Occupancy and revenue rollups ----------------
+//Room-nights held and money settled, per day and room type. Every
+//booking, room change and checkout adjusts the days it touches, so a
+//report over any date range reads one entry per day. rollup.dat is a
+//header and then one Day_Rollup per day from first_day.
+struct Day_Rollup
+{
+	int occupied[ROOM_TYPES];		//rooms held that night
+	int revenue[ROOM_TYPES];		//folios settled that day
+};
+struct Rollup_Totals
+{
+	int days;
+	int rooms[ROOM_TYPES];
+	long long occupied[ROOM_TYPES];
+	long long revenue[ROOM_TYPES];
+};
+
+class Occupancy_Rollup
+{
+	protected:
+		static const int MAGIC=0x4c4c4f52;		//"ROLL"
+		static const int VERSION=1;
+		static const int HEADER_SIZE=16;
+		Journal_Writer journal;
+		int first_day;
+		vector<Day_Rollup> days;
+		mutex lock;
+
+		long offset(int day)
+		{
+			return HEADER_SIZE+(long)(day-first_day)*sizeof(Day_Rollup);
+		}
+		//Grows the table so day exists. The zeroed days go to the file in
+		//one block, committed with the update that needed them.
+		void reach(int day)
+		{
+			int grow=day-first_day+1-(int)days.size();
+			if(grow<=0)
+				return;
+			Day_Rollup zero;
+			memset(&zero,0,sizeof(zero));
+			days.resize(days.size()+grow,zero);
+			vector<Day_Rollup> block(grow,zero);
+			journal_queue.extend(&journal,&block[0],grow*sizeof(Day_Rollup));
+		}
+		void add_nights(int room_type,int a,int b,int delta)
+		{
+			if(room_type<0 || room_type>=ROOM_TYPES)
+				return;
+			a=max(a,first_day);
+			if(a>=b)
+				return;
+			reach(b-1);
+			for(int d=a;d<b;d++)
+				days[d-first_day].occupied[room_type]+=delta;
+			journal_queue.overwrite(&journal,offset(a),&days[a-first_day],(b-a)*sizeof(Day_Rollup));
+		}
+		void add_revenue(int room_type,int day,int amount)
+		{
+			if(room_type<0 || room_type>=ROOM_TYPES || day<first_day)
+				return;
+			reach(day);
+			days[day-first_day].revenue[room_type]+=amount;
+			journal_queue.overwrite(&journal,offset(day),&days[day-first_day],sizeof(Day_Rollup));
+		}
+		//A new rollup.dat starts from the open stays and the settlements.
+		void rebuild()
+		{
+			vector<Settlement_Record> bills;
+			vector<int> check_in;
+			Settlement_Record bill;
+			Booking_Record stay;
+			while(folio_ledger.read(bills.size(),bill))
+			{
+				bills.push_back(bill);
+				check_in.push_back(booking_store.get(bill.booking_id,stay)?stay.check_in:bill.day-bill.nights);
+			}
+			vector<Booking_Record> stays=booking_store.open_stays();
+			first_day=today();
+			for(size_t i=0;i<bills.size();i++)
+				first_day=min(first_day,check_in[i]);
+			for(size_t i=0;i<stays.size();i++)
+				first_day=min(first_day,stays[i].check_in);
+			int header[4]={MAGIC,VERSION,(int)sizeof(Day_Rollup),first_day};
+			journal.append(header,sizeof(header));
+			for(size_t i=0;i<bills.size();i++)
+			{
+				int room_type=room_calendar.type_of(bills[i].room);
+				add_nights(room_type,check_in[i],check_in[i]+bills[i].nights,1);
+				add_revenue(room_type,bills[i].day,bills[i].total);
+			}
+			for(size_t i=0;i<stays.size();i++)
+				add_nights(room_calendar.type_of(stays[i].room),stays[i].check_in,stays[i].check_in+stays[i].days,1);
+		}
+	public:
+		Occupancy_Rollup()
+		{
+			first_day=0;
+		}
+		//Open after the booking store, the calendar and the folio ledger.
+		bool open(const char *path)
+		{
+			if(!journal.open(path))
+				return false;
+			lock_guard<mutex> guard(lock);
+			if(journal.end()==0)
+			{
+				rebuild();
+				journal_queue.wait();
+				journal.commit();
+				return true;
+			}
+			int header[4];
+			if(!journal.read(0,header,sizeof(header)) || header[0]!=MAGIC || header[1]!=VERSION || header[2]!=(int)sizeof(Day_Rollup))
+			{
+				cout<<path<<" is not a rollup file!"<<endl;
+				journal.close();
+				return false;
+			}
+			first_day=header[3];
+			Day_Rollup day;
+			while(journal.read(offset(first_day+days.size()),&day,sizeof(day)))
+				days.push_back(day);
+			return true;
+		}
+		void set_durability(Journal_Writer::Durability how,int n)
+		{
+			journal.set_durability(how,n);
+		}
+		void close()
+		{
+			journal.close();
+		}
+		void booked(const Booking_Record &stay)
+		{
+			lock_guard<mutex> guard(lock);
+			add_nights(room_calendar.type_of(stay.room),stay.check_in,stay.check_in+stay.days,1);
+		}
+		//stay is the booking before the move.
+		void moved(const Booking_Record &stay,int room,int nights)
+		{
+			lock_guard<mutex> guard(lock);
+			add_nights(room_calendar.type_of(stay.room),today(),stay.check_in+stay.days,-1);
+			add_nights(room_calendar.type_of(room),today(),today()+nights,1);
+		}
+		//The nights billed stay counted, the rest of the booking is given back.
+		void settled(const Booking_Record &stay,const Settlement_Record &bill)
+		{
+			lock_guard<mutex> guard(lock);
+			int room_type=room_calendar.type_of(stay.room);
+			add_nights(room_type,stay.check_in+bill.nights,stay.check_in+stay.days,-1);
+			add_revenue(room_type,bill.day,bill.total);
+		}
+		//Sums the days a..b (inclusive).
+		void report(int a,int b,Rollup_Totals &out)
+		{
+			lock_guard<mutex> guard(lock);
+			memset(&out,0,sizeof(out));
+			out.days=max(0,b-a+1);
+			for(int t=0;t<ROOM_TYPES;t++)
+				out.rooms[t]=room_calendar.rooms_of(t);
+			a=max(a,first_day);
+			b=min(b,first_day+(int)days.size()-1);
+			for(int d=a;d<=b;d++)
+				for(int t=0;t<ROOM_TYPES;t++)
+				{
+					out.occupied[t]+=days[d-first_day].occupied[t];
+					out.revenue[t]+=days[d-first_day].revenue[t];
+				}
+		}
+};
+Occupancy_Rollup rollups;
+
+void print_rollup(const Rollup_Totals &r)
+{
+	cout<<left<<setw(18)<<"Room Type"<<right<<setw(10)<<"Nights"<<setw(12)<<"Occupancy"<<setw(12)<<"Revenue"<<endl;
+	for(int t=0;t<ROOM_TYPES;t++)
+	{
+		long long capacity=(long long)r.rooms[t]*r.days;
+		cout<<left<<setw(18)<<room_type_name[t]<<right<<setw(10)<<r.occupied[t]<<setw(11)<<fixed<<setprecision(1)
+			<<(capacity?100.0*r.occupied[t]/capacity:0)<<"%"<<setw(12)<<r.revenue[t]<<endl;
+	}
+}
+
+//---------------- Front desk engine ----------------
+//Desk operations without any prompts; the menus and the batch
+//runner both go through these so they share one set of rules.
+enum Desk_Result { DESK_OK=0, NO_SUCH_ROOM, WRONG_ROOM_TYPE, ROOM_TAKEN, NO_OPEN_STAY, BAD_REQUEST,
+	NO_SUCH_TABLE, TABLE_TOO_SMALL, TABLE_TAKEN, DESK_RESULTS };
+const char *desk_result_text[DESK_RESULTS]={"ok","no such room","wrong room type","room already booked","no open stay","bad request",
+	"no such table","table too small","no free table"};
+
+//---------------- Restaurant tables ----------------
+//Tables are kept sorted by capacity and every half-hour slot of a day
+//has a bitmask of free tables in that order. A party's free tables are
+//the AND of the masks of the slots it sits through, and the best fit is
+//the lowest set bit at or after the first table big enough.
+enum Table_Status { TABLE_BOOKED=1, TABLE_CANCELLED=2 };
+struct Table_Reservation
+{
+	int id;
+	int day;			//day number, as Booking_Record::check_in
+	int slot;			//half hour of the day, 0-47
+	int slots;
+	int table;
+	int party;
+	int status;			//Table_Status
+};
+
+//"HH:MM" -> half-hour slot, or -1.
+int slot_of(const string &time)
+{
+	int hh,mm;
+	char colon;
+	istringstream in(time);
+	if(!(in>>hh>>colon>>mm) || colon!=':' || hh<0 || hh>23 || mm<0 || mm>59)
+		return -1;
+	return (hh*60+mm)/30;
+}
+string slot_text(int slot)
+{
+	ostringstream out;
+	out<<setfill('0')<<setw(2)<<slot/2<<":"<<(slot%2?"30":"00");
+	return out.str();
+}
+int current_slot()
+{
+	time_t now=time(NULL);
+	return (int)(now%86400)/1800;
+}
+
+class Table_Book
+{
+	public:
+		static const int SLOTS=48;			//half hours in a day
+		static const int DINING_SLOTS=3;	//a sitting lasts 90 minutes
+	protected:
+		typedef unsigned long long Word;
+		vector<int> number,capacity;		//tables in capacity order
+		map<int,int> order_of;				//table number -> position
+		int words;
+		map<int,vector<Word> > free_mask;	//day -> SLOTS rows of words, bit set = free
+		vector<Table_Reservation> reservations;
+		Journal_Writer journal;
+		bool persist;
+		mutex lock;
+
+		vector<Word> &day_mask(int day)
+		{
+			map<int,vector<Word> >::iterator it=free_mask.find(day);
+			if(it!=free_mask.end())
+				return it->second;
+			vector<Word> &mask=free_mask[day];
+			mask.assign(SLOTS*words,~0ULL);
+			int tail=number.size()%64;
+			if(tail)
+				for(int s=0;s<SLOTS;s++)
+					mask[s*words+words-1]=(1ULL<<tail)-1;
+			return mask;
+		}
+		//Free tables for [slot,slot+slots), ANDed into out.
+		void free_for(int day,int slot,int slots,vector<Word> &out)
+		{
+			vector<Word> &mask=day_mask(day);
+			out.assign(mask.begin()+slot*words,mask.begin()+(slot+1)*words);
+			for(int s=slot+1;s<slot+slots;s++)
+				for(int w=0;w<words;w++)
+					out[w]&=mask[s*words+w];
+		}
+		void mark(const Table_Reservation &r,bool taken)
+		{
+			vector<Word> &mask=day_mask(r.day);
+			int pos=order_of[r.table];
+			Word bit=1ULL<<(pos%64);
+			for(int s=r.slot;s<r.slot+r.slots;s++)
+				if(taken)
+					mask[s*words+pos/64]&=~bit;
+				else
+					mask[s*words+pos/64]|=bit;
+		}
+		int first_fit(int party)
+		{
+			return lower_bound(capacity.begin(),capacity.end(),party)-capacity.begin();
+		}
+	public:
+		Table_Book()
+		{
+			words=0;
+			persist=false;
+		}
+		//tables.txt holds "table capacity" lines; otherwise 20 tables of 2-8.
+		void load_tables(const char *path)
+		{
+			vector<pair<int,int> > tables;		//capacity,number
+			ifstream fin(path);
+			int table,seats;
+			while(fin>>table>>seats)
+				if(table>0 && seats>0)
+					tables.push_back(make_pair(seats,table));
+			if(tables.empty())
+				for(int t=1;t<=20;t++)
+					tables.push_back(make_pair(t<=6?2:t<=14?4:t<=18?6:8,t));
+			set_tables(tables);
+		}
+		void set_tables(vector<pair<int,int> > tables)
+		{
+			sort(tables.begin(),tables.end());
+			number.clear();
+			capacity.clear();
+			order_of.clear();
+			free_mask.clear();
+			for(size_t i=0;i<tables.size();i++)
+			{
+				order_of[tables[i].second]=number.size();
+				number.push_back(tables[i].second);
+				capacity.push_back(tables[i].first);
+			}
+			words=(number.size()+63)/64;
+		}
+		//Replays saved reservations and appends new ones to path.
+		bool open(const char *path)
+		{
+			if(!journal.open(path))
+				return false;
+			persist=true;
+			Table_Reservation r;
+			long at=0;
+			while(journal.read(at,&r,sizeof(r)))
+			{
+				reservations.push_back(r);
+				if(r.status==TABLE_BOOKED && order_of.count(r.table))
+					mark(r,true);
+				at+=sizeof(r);
+			}
+			return true;
+		}
+		//table 0 picks the smallest free table that seats the party.
+		int reserve(int party,int table,int day,int slot,Table_Reservation &out)
+		{
+			lock_guard<mutex> guard(lock);
+			if(party<=0 || slot<0 || slot>=SLOTS || words==0)
+				return BAD_REQUEST;
+			int slots=min(DINING_SLOTS,SLOTS-slot),pos;
+			vector<Word> open_tables;
+			free_for(day,slot,slots,open_tables);
+			if(table!=0)
+			{
+				map<int,int>::iterator it=order_of.find(table);
+				if(it==order_of.end())
+					return NO_SUCH_TABLE;
+				pos=it->second;
+				if(capacity[pos]<party)
+					return TABLE_TOO_SMALL;
+				if(!(open_tables[pos/64]>>(pos%64)&1))
+					return TABLE_TAKEN;
+			}
+			else
+			{
+				pos=first_fit(party);
+				if(pos>=(int)number.size())
+					return TABLE_TOO_SMALL;
+				int w=pos/64;
+				Word candidates=open_tables[w]&(~0ULL<<(pos%64));
+				while(!candidates && ++w<words)
+					candidates=open_tables[w];
+				if(!candidates)
+					return TABLE_TAKEN;
+				pos=w*64+lowest_bit(candidates);
+			}
+			Table_Reservation r;
+			r.id=reservations.size()+1;
+			r.day=day;
+			r.slot=slot;
+			r.slots=slots;
+			r.table=number[pos];
+			r.party=party;
+			r.status=TABLE_BOOKED;
+			mark(r,true);
+			reservations.push_back(r);
+			if(persist)
+				journal_queue.append(&journal,&r,sizeof(r));
+			out=r;
+			return DESK_OK;
+		}
+		bool cancel(int id)
+		{
+			lock_guard<mutex> guard(lock);
+			if(id<1 || id>(int)reservations.size() || reservations[id-1].status!=TABLE_BOOKED)
+				return false;
+			Table_Reservation &r=reservations[id-1];
+			r.status=TABLE_CANCELLED;
+			mark(r,false);
+			if(persist)
+				journal_queue.overwrite(&journal,(long)(id-1)*sizeof(r),&r,sizeof(r));
+			return true;
+		}
+		//How many tables seating the party are free for a sitting at slot.
+		int free_tables(int party,int day,int slot)
+		{
+			lock_guard<mutex> guard(lock);
+			if(slot<0 || slot>=SLOTS || words==0)
+				return 0;
+			vector<Word> open_tables;
+			free_for(day,slot,min(DINING_SLOTS,SLOTS-slot),open_tables);
+			int pos=first_fit(party),count=0;
+			for(int p=pos;p<(int)number.size();p++)
+				count+=open_tables[p/64]>>(p%64)&1;
+			return count;
+		}
+		void close()
+		{
+			journal.close();
+		}
+};
+const int Table_Book::DINING_SLOTS;		//min() takes it by reference
+Table_Book table_book;
+
+
+//A room's check and reserve run under one of a fixed set of lock
+//stripes, so two desks can't both take the same room. The stripes are
+//not the only locks a booking takes: the calendar, the booking store's
+//id counter and indexes, the guest directory and the rollups are shared
+//by every room and each has one mutex, so bookings for different rooms
+//still pass through those one at a time. Those mutexes cover in-memory
+//updates only; the disk is written by the background writers, and a desk
+//waits on them under a shared lock only when their queues are full.
+class Front_Desk
+{
+	protected:
+		static const int STRIPES=64;
+		mutex stripe[STRIPES];
+
+		mutex &lock_of(int room)
+		{
+			return stripe[(unsigned)room%STRIPES];
+		}
+		//A room of room_type free for days nights from today, its nights
+		//reserved, or 0. Rooms the calendar offers that an overdue stay
+		//still holds are passed over.
+		int allocate(int room_type,int days)
+		{
+			vector<int> held;
+			Booking_Record open;
+			int room;
+			while((room=room_calendar.allocate(room_type,today(),today()+days)) && booking_store.find_active(room,open))
+				held.push_back(room);
+			for(size_t i=0;i<held.size();i++)
+				room_calendar.release(held[i],today(),today()+days);
+			return room;
+		}
+	public:
+		static const int MAX_NIGHTS=3660;	//ten years; bounds the calendar's bitsets
+
+		//room_type<0 accepts any type; the caller holds the room's stripe.
+		//An overdue stay has given its nights back to the calendar but
+		//still holds the room, so the open stay is checked as well.
+		int check(int room,int days,int room_type)
+		{
+			if(days<=0 || days>MAX_NIGHTS)
+				return BAD_REQUEST;
+			if(!room_calendar.exists(room))
+				return NO_SUCH_ROOM;
+			if(room_type>=0 && room_calendar.type_of(room)!=room_type)
+				return WRONG_ROOM_TYPE;
+			Booking_Record open;
+			if(booking_store.find_active(room,open) || !room_calendar.is_free(room,today(),today()+days))
+				return ROOM_TAKEN;
+			return DESK_OK;
+		}
+		//Rooms of room_type that check() would accept for days nights.
+		vector<int> free_rooms(int room_type,int days)
+		{
+			vector<int> rooms=room_calendar.free_rooms(room_type,today(),today()+days),free;
+			Booking_Record open;
+			for(size_t i=0;i<rooms.size();i++)
+				if(!booking_store.find_active(rooms[i],open))
+					free.push_back(rooms[i]);
+			return free;
+		}
+		//Books rec.room for rec.days nights from today; sets rec.id. A new
+		//guest is registered, setting rec.guest, only once the room is held.
+		int book(Booking_Record &rec,int room_type,const Guest_Details *guest=NULL)
+		{
+			if(rec.room==0)
+				return book_any(rec,room_type,guest);
+			lock_guard<mutex> guard(lock_of(rec.room));
+			int result=check(rec.room,rec.days,room_type);
+			if(result!=DESK_OK)
+				return result;
+			if(!room_calendar.reserve(rec.room,today(),today()+rec.days))
+				return ROOM_TAKEN;
+			open_stay(rec,guest);
+			return DESK_OK;
+		}
+		//Room 0: the allocator picks and reserves a room of room_type.
+		int book_any(Booking_Record &rec,int room_type,const Guest_Details *guest=NULL)
+		{
+			if(room_type<0 || room_type>=ROOM_TYPES || rec.days<=0 || rec.days>MAX_NIGHTS)
+				return BAD_REQUEST;
+			rec.room=allocate(room_type,rec.days);
+			if(!rec.room)
+				return ROOM_TAKEN;
+			lock_guard<mutex> guard(lock_of(rec.room));
+			open_stay(rec,guest);
+			return DESK_OK;
+		}
+		//Moves the open stay of old to room for days more nights (0 = the
+		//nights left on the stay); room_type -1 accepts any type. Both
+		//rooms stay locked throughout: the new nights are held first, the
+		//stay is rewritten in one journal entry, and only then are the old
+		//nights given back, so the stay is never in no room. Room 0 lets
+		//the allocator pick one of room_type (default: the old room's type)
+		//and is set to the room picked.
+		int change_room(int old,int &room,int days,int room_type=-1)
+		{
+			if(room==0)
+				return change_to_any(old,room,days,room_type);
+			mutex &a=lock_of(old),&b=lock_of(room);
+			unique_lock<mutex> first(a,defer_lock),second(b,defer_lock);
+			if(&a==&b)
+				first.lock();
+			else
+				std::lock(first,second);
+			Booking_Record stay;
+			if(!booking_store.find_active(old,stay))
+				return NO_OPEN_STAY;
+			if(room==old || days<0)
+				return BAD_REQUEST;
+			if(days==0)
+				days=max(1,stay.check_in+stay.days-today());
+			int result=check(room,days,room_type);
+			if(result!=DESK_OK)
+				return result;
+			if(!room_calendar.reserve(room,today(),today()+days))
+				return ROOM_TAKEN;
+			return move_stay(stay,room,days);
+		}
+		int change_to_any(int old,int &room,int days,int room_type)
+		{
+			lock_guard<mutex> guard(lock_of(old));
+			Booking_Record stay;
+			if(!booking_store.find_active(old,stay))
+				return NO_OPEN_STAY;
+			if(days<0 || days>MAX_NIGHTS || room_type>=ROOM_TYPES)
+				return BAD_REQUEST;
+			if(days==0)
+				days=max(1,stay.check_in+stay.days-today());
+			//old itself is passed over too, as it holds the stay being moved.
+			int picked=allocate(room_type<0?room_calendar.type_of(old):room_type,days);
+			if(!picked)
+				return ROOM_TAKEN;
+			int result=move_stay(stay,picked,days);
+			if(result==DESK_OK)
+				room=picked;
+			return result;
+		}
+		//table 0 picks the best-fitting free table.
+		int book_table(int party,int table,int slot,Table_Reservation &r)
+		{
+			return table_book.reserve(party,table,today(),slot,r);
+		}
+		int folio(int room,Settlement_Record &bill)
+		{
+			lock_guard<mutex> guard(lock_of(room));
+			Booking_Record stay;
+			if(!booking_store.find_active(room,stay))
+				return NO_OPEN_STAY;
+			make_folio(stay,0,bill);
+			return DESK_OK;
+		}
+		int post_charge(int room,int amount)
+		{
+			lock_guard<mutex> guard(lock_of(room));
+			if(amount<=0)
+				return BAD_REQUEST;
+			return booking_store.post_charge(room,amount)?DESK_OK:NO_OPEN_STAY;
+		}
+		//Settles the folio, frees the room and appends the settlement.
+		int checkout(int room,int pay_mode,Settlement_Record &bill)
+		{
+			lock_guard<mutex> guard(lock_of(room));
+			Booking_Record stay;
+			if(!booking_store.checkout(room,stay))
+				return NO_OPEN_STAY;
+			make_folio(stay,pay_mode,bill);
+			folio_ledger.append(bill);
+			rollups.settled(stay,bill);
+			return DESK_OK;
+		}
+		bool find(int room,Booking_Record &rec)
+		{
+			lock_guard<mutex> guard(lock_of(room));
+			return booking_store.find_active(room,rec);
+		}
+	protected:
+		//The nights are already reserved; the caller holds the room's stripe.
+		void open_stay(Booking_Record &rec,const Guest_Details *guest)
+		{
+			if(guest)
+				rec.guest=guest_directory.register_guest(*guest);
+			rec.check_in=today();
+			rec.status=BOOKED;
+			rec.amount=rate_calendar.quote(room_calendar.type_of(rec.room),rec.check_in,rec.days);
+			rec.rate=rec.amount/rec.days;
+			booking_store.add(rec);
+			rollups.booked(rec);
+		}
+		//room's new nights are already reserved. The caller found the stay
+		//under its stripe, so the move fails only if room holds a stay.
+		int move_stay(const Booking_Record &stay,int room,int days)
+		{
+			if(!booking_store.move(stay.room,room,days,room_charge_until(stay,today())))
+			{
+				room_calendar.release(room,today(),today()+days);
+				return ROOM_TAKEN;
+			}
+			room_calendar.release(stay.room,today(),stay.check_in+stay.days);
+			rollups.moved(stay,room,days);
+			return DESK_OK;
+		}
+};
+Front_Desk front_desk;
+
+//---------------- Night audit ----------------
+//Closes a business day: posts that night's room charge to every occupied
+//room, flags stays past their checkout day and sums the daily report.
+//The open stays are split by floor (room/100) and the floors are shared
+//out to a pool of threads; the postings then go to audit.dat as one
+//append and one commit. audit.dat is, per audited night, an Audit_Header
+//followed by its Night_Posting records.
+struct Night_Posting
+{
+	int day;
+	int booking_id;
+	int room;
+	int amount;			//rate of the room's type that night
+	int overdue;		//1 if the stay was due out by this day
+};
+struct Audit_Header
+{
+	int magic;
+	int day;			//business day closed
+	int postings;		//Night_Posting records that follow
+	int overdue;
+	int occupied[ROOM_TYPES];
+	int posted[ROOM_TYPES];		//room charges posted
+};
+struct Audit_Report
+{
+	Audit_Header totals;
+	int arrivals;		//checked in on the day
+	int due_out;		//due to leave the next morning
+	vector<int> overdue_rooms;
+	Rollup_Totals settled;		//the day's rollup
+	double millis;
+};
+
+class Night_Audit
+{
+	protected:
+		static const int MAGIC=0x54445541;		//"AUDT"
+		Journal_Writer journal;
+		int business_day;		//first night not yet audited
+		int workers;
+		mutex lock;				//one audit at a time
+
+		static void reset(Audit_Report &r)
+		{
+			memset(&r.totals,0,sizeof(r.totals));
+			r.arrivals=r.due_out=0;
+			r.overdue_rooms.clear();
+		}
+		static void add(Audit_Report &into,const Audit_Report &part)
+		{
+			into.totals.postings+=part.totals.postings;
+			into.totals.overdue+=part.totals.overdue;
+			for(int t=0;t<ROOM_TYPES;t++)
+			{
+				into.totals.occupied[t]+=part.totals.occupied[t];
+				into.totals.posted[t]+=part.totals.posted[t];
+			}
+			into.arrivals+=part.arrivals;
+			into.due_out+=part.due_out;
+			into.overdue_rooms.insert(into.overdue_rooms.end(),part.overdue_rooms.begin(),part.overdue_rooms.end());
+		}
+		//Audits the stays of one floor; reads only, so floors run in parallel.
+		static void audit_floor(const vector<Booking_Record> &stays,const vector<int> &floor,int day,
+			Audit_Report &report,vector<Night_Posting> &postings)
+		{
+			for(size_t i=0;i<floor.size();i++)
+			{
+				const Booking_Record &stay=stays[floor[i]];
+				int room_type=room_calendar.type_of(stay.room);
+				if(stay.check_in>day || room_type<0)
+					continue;
+				Night_Posting p;
+				p.day=day;
+				p.booking_id=stay.id;
+				p.room=stay.room;
+				p.amount=rate_calendar.rate_of(room_type,day);
+				p.overdue=stay.check_in+stay.days<=day;
+				postings.push_back(p);
+				report.totals.postings++;
+				report.totals.occupied[room_type]++;
+				report.totals.posted[room_type]+=p.amount;
+				report.arrivals+=stay.check_in==day;
+				report.due_out+=stay.check_in+stay.days==day+1;
+				if(p.overdue)
+				{
+					report.totals.overdue++;
+					report.overdue_rooms.push_back(stay.room);
+				}
+			}
+		}
+	public:
+		Night_Audit()
+		{
+			business_day=today();
+			workers=max(1u,thread::hardware_concurrency());
+		}
+		//The business day follows the last night recorded in path.
+		bool open(const char *path)
+		{
+			if(!journal.open(path))
+				return false;
+			Audit_Header header;
+			long at=0;
+			while(journal.read(at,&header,sizeof(header)))
+			{
+				if(header.magic!=MAGIC)
+				{
+					cout<<path<<" is not an audit file!"<<endl;
+					journal.close();
+					return false;
+				}
+				business_day=header.day+1;
+				at+=sizeof(header)+(long)header.postings*sizeof(Night_Posting);
+			}
+			return true;
+		}
+		void close()
+		{
+			journal.close();
+		}
+		int business_date()
+		{
+			lock_guard<mutex> guard(lock);
+			return business_day;
+		}
+		void set_workers(int n)
+		{
+			workers=max(1,n);
+		}
+		//Audits night day over the given stays; nothing is written.
+		void audit(const vector<Booking_Record> &stays,int day,Audit_Report &report,vector<Night_Posting> &postings)
+		{
+			chrono::steady_clock::time_point start=chrono::steady_clock::now();
+			vector<vector<int> > floors;
+			unordered_map<int,int> floor_of;
+			for(size_t i=0;i<stays.size();i++)
+			{
+				unordered_map<int,int>::iterator it=floor_of.find(stays[i].room/100);
+				if(it==floor_of.end())
+				{
+					it=floor_of.insert(make_pair(stays[i].room/100,(int)floors.size())).first;
+					floors.push_back(vector<int>());
+				}
+				floors[it->second].push_back(i);
+			}
+			vector<Audit_Report> parts(floors.size());
+			vector<vector<Night_Posting> > posted(floors.size());
+			for(size_t f=0;f<floors.size();f++)
+				reset(parts[f]);
+			atomic<int> next(0);
+			vector<thread> pool;
+			int threads=min(workers,(int)floors.size());
+			for(int w=0;w<threads;w++)
+				pool.push_back(thread([&]
+				{
+					for(int f=next++;f<(int)floors.size();f=next++)
+						audit_floor(stays,floors[f],day,parts[f],posted[f]);
+				}));
+			for(size_t w=0;w<pool.size();w++)
+				pool[w].join();
+			reset(report);
+			report.totals.magic=MAGIC;
+			report.totals.day=day;
+			postings.clear();
+			for(size_t f=0;f<floors.size();f++)
+			{
+				add(report,parts[f]);
+				postings.insert(postings.end(),posted[f].begin(),posted[f].end());
+			}
+			sort(report.overdue_rooms.begin(),report.overdue_rooms.end());
+			rollups.report(day,day,report.settled);
+			report.millis=chrono::duration<double,milli>(chrono::steady_clock::now()-start).count();
+		}
+		//Closes night day (default: the business day) and rolls the business
+		//day past it. Nights already audited and nights to come are refused.
+		int run(int day,Audit_Report &report)
+		{
+			lock_guard<mutex> guard(lock);
+			if(day<0)
+				day=business_day;
+			if(day<business_day || day>today())
+				return BAD_REQUEST;
+			vector<Night_Posting> postings;
+			audit(booking_store.open_stays(),day,report,postings);
+			string batch((const char*)&report.totals,sizeof(report.totals));
+			if(!postings.empty())
+				batch.append((const char*)&postings[0],postings.size()*sizeof(Night_Posting));
+			journal.append(batch.data(),batch.size());
+			journal.commit();
+			business_day=day+1;
+			return DESK_OK;
+		}
+};
+Night_Audit night_audit;
+
+void print_audit(const Audit_Report &r)
+{
+	cout<<"\n-------Night Audit "<<date_text(r.totals.day)<<"-------"<<endl;
+	cout<<left<<setw(18)<<"Room Type"<<right<<setw(10)<<"In-House"<<setw(12)<<"Occupancy"<<setw(12)<<"Posted"<<setw(12)<<"Settled"<<endl;
+	for(int t=0;t<ROOM_TYPES;t++)
+		cout<<left<<setw(18)<<room_type_name[t]<<right<<setw(10)<<r.totals.occupied[t]<<setw(11)<<fixed<<setprecision(1)
+			<<(r.settled.rooms[t]?100.0*r.totals.occupied[t]/r.settled.rooms[t]:0)<<"%"<<setw(12)<<r.totals.posted[t]<<setw(12)<<r.settled.revenue[t]<<endl;
+	cout<<"Arrivals-->"<<r.arrivals<<endl;
+	cout<<"Due Out Tomorrow-->"<<r.due_out<<endl;
+	cout<<"Overdue Checkouts-->"<<r.totals.overdue;
+	for(size_t i=0;i<r.overdue_rooms.size();i++)
+		cout<<(i?", ":" (Rooms ")<<r.overdue_rooms[i]<<(i+1==r.overdue_rooms.size()?")":"");
+	cout<<endl<<"Business Date-->"<<date_text(r.totals.day+1)<<endl;
+}
+
+//Prints why a room can't be booked and what is free instead.
+//Room 0 asks the allocator, so only the days and a free room of the type are checked.
+bool check_room(int room,int days,int room_type)
+{
+	if(room==0)
+	{
+		if(days<=0 || days>Front_Desk::MAX_NIGHTS)
+			cout<<"\nInvalid Number Of Days!\n";
+		else if(front_desk.free_rooms(room_type,days).empty())
+			cout<<"\nNo "<<room_type_name[room_type]<<" Room Is Free For These Days!\n";
+		else
+			return true;
+		return false;
+	}
+	int result=front_desk.check(room,days,room_type);
+	switch(result)
+	{
+		case DESK_OK:
+			return true;
+		case NO_SUCH_ROOM:
+			cout<<"\nRoom "<<room<<" Is Not In This Hotel!\n";
+			return false;
+		case WRONG_ROOM_TYPE:
+			cout<<"\nRoom "<<room<<" Is Not A "<<room_type_name[room_type]<<" Room!\n";
+			break;
+		case ROOM_TAKEN:
+			cout<<"\nRoom "<<room<<" Is Already Booked For These Days!\n";
+			break;
+		default:
+			cout<<"\nInvalid Number Of Days!\n";
+			return false;
+	}
+	if(room_type<0)
+		room_type=room_calendar.type_of(room);
+	vector<int> rooms=front_desk.free_rooms(room_type,days);
+	cout<<"Free "<<room_type_name[room_type]<<" Rooms-->";
+	for(size_t i=0;i<rooms.size();i++)
+		cout<<rooms[i]<<" ";
+	cout<<endl;
+	return false;
+}
+//room 0 is filled in with the room the allocator picked; details, for
+//a guest not registered yet, are registered once the room is booked.
+int save_booking(int room_type,int &room,int days,int Pay,int guest,const Guest_Details *details=NULL)
+{
+	Booking_Record rec;
+	memset(&rec,0,sizeof(rec));
+	rec.room=room;
+	rec.days=days;
+	rec.pay_mode=(Pay==1 || Pay==2)?Pay:0;
+	rec.guest=guest;
+	if(front_desk.book(rec,room_type,details)!=DESK_OK)
+		return 0;
+	room=rec.room;
+	return rec.id;
+}
+
+//The menus keep no state of their own; each prompt reads into locals
+//and the booking itself goes straight to the front desk.
+class Base
+{
+	protected:
+		template<class Room,class Bed> void set_booking()
+		{
+						typedef Tariff<Room,Bed> Rate;
+						int n,Pay,room,payment;
+						long double Mobile;
+						char gen[8];
+						string name,adhaar,add;
+						Guest_Record g;
+						cout<<"Enter valid Mobile Number +91-->";
+						cin>>Mobile;
+						int guest=guest_directory.find(mobile_text(Mobile),"");
+						if(guest && guest_directory.get(guest,g))
+							cout<<"Welcome Back "<<g.name<<"!\n";
+						cout<<"Enter Room Number of Clinte (0 for any free room)-->";
+						cin>>room;
+						if(!guest)
+						{
+							cout<<"Enter Name of Client-->";
+							fflush(stdin);
+							getline(cin,name);
+						}
+						cout<<"How many days Book Room?-->";
+						fflush(stdin);
+						cin>>n;
+						if(!check_room(room,n,Rate::room_type))
+							return;
+						if(!guest)
+						{
+							cout<<"Enter Aadhar Number /xxxx-xxxx-xxxx/->";
+							fflush(stdin);
+							getline(cin,adhaar);
+							cout<<"Enter Address-->";
+							fflush(stdin);
+							getline(cin,add);
+							cout<<"Enter gender-->";
+							fflush(stdin);
+							cin>>setw(sizeof(gen))>>gen;
+						}
+						Guest_Details details={mobile_text(Mobile),name,adhaar,add,gen};
+						int fees=rate_calendar.quote(Rate::room_type,today(),n);
+						cout<<"Your room fees is->"<<fees;
+						cout<<endl<<"\nHow to pay  this payment\n1.online Payment in mobile-number 2.offline payment on a counter\n-->";
+						fflush(stdin);
+						cin>>Pay;
+						cout<<endl;
+							switch(Pay)
+						{
+							case 1:
+							{
+								cout<<"The mobile number of hotel is-+91 9099226684\nPay Room Fees-->";
+								cin>>payment;
+								cout<<endl;
+								cout<<"Payment SucssesFull.!\n"<<endl;
+								cout<<endl;
+								break;
+							}
+							case 2:
+							{	
+								break;				
+							}
+							default:
+							{
+								cout<<"Payment Canceld!\n";	
+							}	
+						}
+						cout<<endl;
+						int id=save_booking(Rate::room_type,room,n,Pay,guest,guest?NULL:&details);
+						if(!id)
+						{
+							cout<<"Room Was Taken Meanwhile, Booking Canceld!"<<endl;
+							return;
+						}
+						cout<<"Booking Id-->"<<id<<endl;
+						cout<<"Room Number-->"<<room<<endl;
+						cout<<"SucssesFully Booked!"<<endl;					
+		}
+		//Room_Type asked for, -1 for any other answer.
+		int Function_2()
+		{
+			string  user,userChoice; 
+			
+			cout<<"\n1.AC-ROOM or 2.NON-AC Room?";
+			fflush(stdin);
+			cin>>user;
+			cout<<"\n1.Single-Bad or 2.Double-Bad?";
+			fflush(stdin);
+			cin>>userChoice;
+			if((user!="1" && user!="2") || (userChoice!="1" && userChoice!="2"))
+				return -1;
+			return (user=="2")*2+(userChoice=="2");
+		}
+		void set_3()
+		{
+			int Table,number1,slot;
+			string when;
+			Table_Reservation r;
+			cout<<"How Many Mans For Book Table?-->";
+			cin>>Table;
+			cout<<"\nAt What Time? (HH:MM or now)-->";
+			cin>>when;
+			slot=when=="now"?current_slot():slot_of(when);
+			cout<<"Free Tables For "<<Table<<"-->"<<table_book.free_tables(Table,today(),slot);
+			cout<<"\nWhat is Table Number of Client? (0 for best table)-->";
+			cin>>number1;
+			int result=front_desk.book_table(Table,number1,slot,r);
+			if(result!=DESK_OK)
+			{
+				cout<<"\nCan't Book Table: "<<desk_result_text[result]<<"!\n";
+				return;
+			}
+			cout<<"\nSucssesfully Book Table "<<r.table<<" At "<<slot_text(r.slot)<<"!!\n";
+			int room,bill;
+			cout<<"Charge Bill To Room Number (0 to pay at table)-->";
+			cin>>room;
+			if(room==0)
+				return;
+			cout<<"Bill Amount-->";
+			cin>>bill;
+			if(front_desk.post_charge(room,bill)==DESK_OK)
+				cout<<"Bill Added To Room "<<room<<"!\n";
+			else
+				cout<<"Can't Charge Room "<<room<<"!\n";
+		}
+	
+		
+};
+class F_Derived
+{
+	protected:
+		bool Set_F2(int old,long double mobile,int room_type)
+		{
+				int room,n;
+				Booking_Record stay;
+				if(!front_desk.find(old,stay))
+				{
+					cout<<"\nNo Active Booking For Room "<<old<<"!\n";
+					return false;
+				}
+				if(guest_directory.find(mobile_text(mobile),"")!=stay.guest)
+				{
+					cout<<"\nMobile Number Is Not Of The Guest In Room "<<old<<"!\n";
+					return false;
+				}
+				cout<<"Enter New-Room Number of Clinte (0 for any free room)-->";
+				fflush(stdin);
+				cin>>room;
+				cout<<"How many days Book Room ?? (0 for "<<max(1,stay.check_in+stay.days-today())<<" nights left)\n-->";
+				fflush(stdin);
+				cin>>n;
+				if(n==0)
+					n=max(1,stay.check_in+stay.days-today());
+				if(!check_room(room,n,room==0 && room_type<0?room_calendar.type_of(old):room_type))
+					return false;
+				int result=front_desk.change_room(old,room,n,room_type);
+				if(result!=DESK_OK)
+				{
+					cout<<"\nCan't Change Room: "<<desk_result_text[result]<<"!\n";
+					return false;
+				}
+				cout<<endl;
+				cout<<"New Room Number-->"<<room<<endl;
+				cout<<"SucssesFully Booked!"<<endl;	
+				return true;
+		}	
+		void Print_set()
+		{
+			int how,key,more=1;
+			string text;
+			Booking_Record rec;
+			Booking_Filter filter;
+			cout<<"1.Search Records 2.By Booking Id 3.Occupancy And Revenue 4.Save Desk Stats 5.Night Audit\n-->";
+			cin>>how;
+			if(how==5)
+			{
+				Audit_Report report;
+				if(night_audit.run(-1,report)==DESK_OK)
+					print_audit(report);
+				else
+					cout<<"Business Date "<<date_text(night_audit.business_date())<<" Is Not Over Yet!\n";
+				return;
+			}
+			if(how==4)
+			{
+				if(desk_stats.dump(stats_path))
+					cout<<"Desk Stats Saved In "<<stats_path<<"\n";
+				return;
+			}
+			if(how==3)
+			{
+				Rollup_Totals totals;
+				cout<<"From YYYY-MM-DD-->";
+				cin>>text;
+				key=day_of(text);
+				cout<<"To YYYY-MM-DD-->";
+				cin>>text;
+				if(key<0 || day_of(text)<key)
+				{
+					cout<<"Invalid Dates!\n";
+					return;
+				}
+				rollups.report(key,day_of(text),totals);
+				print_rollup(totals);
+				return;
+			}
+			if(how==2)
+			{
+				cout<<"Enter Booking Id-->";
+				cin>>key;
+				if(booking_store.get(key,rec))
+					booking_store.print(rec);
+				else
+					cout<<"No Record For This Id!\n";
+				return;
+			}
+			cout<<"Room Number (0 for any)-->";
+			cin>>filter.room;
+			cout<<"Guest Name (- for any)-->";
+			cin>>text;
+			if(text!="-")
+				filter.use_name(text);
+			cout<<"Check-In From YYYY-MM-DD (- for any)-->";
+			cin>>text;
+			filter.from_day=day_of(text);
+			cout<<"Check-In To YYYY-MM-DD (- for any)-->";
+			cin>>text;
+			filter.to_day=day_of(text);
+			cout<<"Payment 0.Any 1.Online 2.Counter 3.Canceld-->";
+			cin>>key;
+			filter.pay_mode=key==1 || key==2?key:key==3?0:-1;
+			static Booking_Viewer viewer("1.dat");
+			vector<const Booking_Record*> page;
+			int cursor=0,shown=0;
+			while(more==1)
+			{
+				cursor=viewer.page(filter,cursor,10,page);
+				for(size_t i=0;i<page.size();i++)
+					booking_store.print(*page[i]);
+				shown+=page.size();
+				if(cursor==0)
+					break;
+				cout<<"\nEnter 1.Next Page 2.Stop-->";
+				cin>>more;
+			}
+			if(shown==0)
+				cout<<"No Record Found!\n";
+		}
+			void set_4()
+		{
+			int Room_number,PAY,PayMent=0;
+			string ANY;
+			Settlement_Record bill;
+			cout<<"What is Room-Number Before Check out?-->";
+			cin>>Room_number;
+			if(front_desk.folio(Room_number,bill)!=DESK_OK)
+			{
+				cout<<"\nNo Active Booking For This Room!";
+				return;
+			}
+			print_folio(bill);
+			cout<<"\nBill is Pay or not?\n1.pay2.not-pay\n-->";
+			cin>>PAY;
+			if(PAY!=1 && PAY!=2)
+				return;
+			while(PAY==2 && PayMent!=1)
+			{
+				cout<<"\nPay Payment";
+				cout<<"\nPay Room-Payment on Counter\n1.Yes or 2.No-->";
+				cin>>PayMent;
+				if(PayMent==1)
+					cout<<"\nOK Room Payment Is Payed.";
+				else if(PayMent==2)
+					cout<<"\nPay-First Room PayMent And After Check Out.";
+				else
+				{
+					cout<<"\nSomeThing Error!";
+					return;
+				}
+			}
+			cout<<"Enter rating for hotel from Client?\n 1-star\n 2-star\n 3-star\n 4-star\n 5-star\n-->";
+			fflush(stdin);
+			cin>>ANY;
+			if(front_desk.checkout(Room_number,PAY==1?1:2,bill)!=DESK_OK)
+			{
+				cout<<"\nNo Active Booking For This Room!";
+				return;
+			}
+			print_folio(bill);
+			cout<<"Room is Sucssesfully_check-out.";	
+		}
+};
+class New:public F_Derived,public Base
+{
+	protected:
+		void set_a()
+		{
+			int chh;
+			lop:
+			cout<<"1.Ac Room\n2.Non Ac Room\n-->";
+			cin>>chh;
+			cout<<endl;
+			switch(chh)
+			{
+				case 1:
+					{
+						set_booking<Ac_Room,Single_Bed>();
+						break;
+					}
+				case 2:
+					{
+						set_booking<Non_Ac_Room,Single_Bed>();
+						break;
+					}
+				default:
+					{
+						cout<<"Incorect case!\n";
+						goto lop;
+					}
+			}
+		}
+			void set_b()
+		{
+			int chh;
+			cout<<"1.Ac Room\n2.Non Ac Room\n-->";
+			cin>>chh;
+			cout<<endl;
+			switch(chh)
+			{
+				case 1:
+					{
+						set_booking<Ac_Room,Double_Bed>();
+						break;
+					}
+				case 2:
+					{
+						set_booking<Non_Ac_Room,Double_Bed>();
+						break;
+					}
+			}
+		}
+		void set_6()
+		{
+			cout<<"Saving Bookings...\n";
+			booking_store.commit();
+			exit(0);
+		
+		}
+		void set_2()
+		{
+				int old;
+				long double mobile;
+				string NAME;
+				cout<<"Enter old Room-Number-->";
+				cin>>old;
+				cout<<"Enter Mobile-Number +91-->";
+				cin>>mobile;
+				cout<<"Enter Any Reson to Change A Room-->";\
+				fflush(stdin);
+				cin>>NAME;
+				int room_type=Function_2();//line 281
+				if(!Set_F2(old,mobile,room_type))//line 133
+					return;
+				cout<<"SucssesFully Changed Room.!";
+		}	
+		void set_1()
+		{
+			int ch;
+			cout<<"1.Single Bad Room\n2.Double Bad Room\n-->";
+			cin>>ch;
+			cout<<endl;
+			switch(ch)
+			{
+				case 1:
+					{
+						set_a();
+						break;
+					}
+				case 2:
+					{
+						set_b();
+						break;
+					}
+			}
+		}
+};
+class Buisness:public New
+{
+	protected:
+		void PutData()
+		{
+			int ch,Mchoice;
+			lable:
+			Main:
+			cout<<"1.Book A Room\n2.Change A Room\n3.Book Table In Resturant\n4.Check Out From Hotel\n5.See Recorde Of Rooms\n6.Exit\n-->";
+			cin>>ch;
+			switch(ch)
+			{
+				case 1:
+					{
+						Action_Timer timer(ACT_BOOK);
+						set_1();//line 420
+						break;
+					}
+				case 2:
+					{
+						Action_Timer timer(ACT_CHANGE);
+						set_2();//line 407
+						break;
+				 	}
+				case 3:
+					{
+						Action_Timer timer(ACT_TABLE);
+						set_3();//line 143
+						break;	
+					}
+				case 4:
+					{
+						Action_Timer timer(ACT_CHECKOUT);
+						set_4();//line 305
+						break;
+					}
+				case 5:
+					{
+						Action_Timer timer(ACT_RECORDS);
+						Print_set();//line 293
+						break;
+					}
+					case 6:
+					{
+						Action_Timer timer(ACT_EXIT);
+						timer.stop();
+						set_6();//line 402
+						break;
+					}
+				default:
+						cout<<"--------------------------------------"<<endl;
+						cout<<"Invalid Choice Please Re-Enter Choice\n";
+						cout<<"--------------------------------------"<<endl;
+						goto lable;
+			}
+			cout<<"\nEnter 1.For Continue 2. For End -->";
+			cin>>Mchoice;
+			switch(Mchoice)
+			{
+				case 1:
+					{
+						goto Main;
+						break;
+					}
+				case 2:
+					{
+						break;
+					}
+			}	
+		}
+};
+class author:public Buisness//author derived from Buisness
+{
+		protected:
+			int n,user,loop;
+			void get()
+			{
+				cout<<"enter  valid id number-->";
+				cin>>user;
+			}
+			public:
+				author()
+				{
+					loop:
+					get();//line-355
+					n=9636;
+					if(user==n)
+					{
+						cout<<"----------Welcome user--------"<<endl;
+						PutData();
+					}
+					else
+					{
+						cout<<"---------------------------"<<endl;
+						cout<<"Incorect user Id!! Re-Enter"<<endl;
+						cout<<"---------------------------"<<endl;
+						goto loop;
+					}
+			}	
+			~author()
+			{
+				cout<<endl<<"---------------------------"<<endl;
+				cout<<"Sucssesfully work is done.\n"<<endl;
+				cout<<"---------------------------"<<endl;
+			}
+};
+//---------------- Desk commands ----------------
+//Batch mode and the desk service read the same '|' separated commands:
+//  book|type|room(0=allocate)|days|pay|mobile|name|adhaar|address|gender
+//  change|old-room|new-room(0=allocate)|days(0=nights left)[|type]
+//  table|party|table-number(0=best fit)[|HH:MM]
+//  checkout|room[|pay 1 online,2 counter]
+//  charge|room|amount
+//  find|room
+//  quote|YYYY-MM-DD|nights  (price of the stay for each room type)
+//  report|YYYY-MM-DD|YYYY-MM-DD  (nights/room-nights:revenue per room type)
+//  stats  (writes the desk counters as JSON to the --stats file, default stats.json)
+//  audit[|YYYY-MM-DD]  (night audit of the business date: in-house posted overdue millis)
+vector<string> split_command(const string &line)
+{
+	vector<string> fields;
+	size_t start=0,bar;
+	while((bar=line.find('|',start))!=string::npos)
+	{
+		fields.push_back(line.substr(start,bar-start));
+		start=bar+1;
+	}
+	fields.push_back(line.substr(start));
+	return fields;
+}
+int field_number(const vector<string> &f,size_t i)
+{
+	return i<f.size()?atoi(f[i].c_str()):0;
+}
+//Runs one command; reply gets the booking id (book) or stay (find).
+int desk_action_of(const string &cmd)
+{
+	if(cmd=="book")
+		return ACT_BOOK;
+	if(cmd=="change")
+		return ACT_CHANGE;
+	if(cmd=="table")
+		return ACT_TABLE;
+	if(cmd=="checkout")
+		return ACT_CHECKOUT;
+	if(cmd=="charge")
+		return ACT_CHARGE;
+	if(cmd=="find" || cmd=="report" || cmd=="quote")
+		return ACT_RECORDS;
+	return ACT_NONE;
+}
+
+int run_command(const vector<string> &f,string &reply)
+{
+	const string &cmd=f[0];
+	ostringstream out;
+	if(cmd=="stats")
+	{
+		if(f.size()>=2)
+			return BAD_REQUEST;
+		reply=stats_path;
+		return desk_stats.dump(stats_path)?DESK_OK:BAD_REQUEST;
+	}
+	Action_Timer timer(desk_action_of(cmd));
+	if(cmd=="book" && f.size()>=10)
+	{
+		Booking_Record rec;
+		memset(&rec,0,sizeof(rec));
+		int room_type=field_number(f,1);
+		if(room_type<0 || room_type>=ROOM_TYPES)
+			return BAD_REQUEST;
+		rec.room=field_number(f,2);
+		rec.days=field_number(f,3);
+		rec.pay_mode=field_number(f,4);
+		Guest_Details guest={f[5],f[6],f[7],f[8],f[9]};
+		int result=front_desk.book(rec,room_type,&guest);
+		out<<rec.id<<" "<<rec.amount<<" "<<rec.room;
+		reply=out.str();
+		return result;
+	}
+	if(cmd=="change" && f.size()>=4)
+	{
+		int room=field_number(f,2);
+		int result=front_desk.change_room(field_number(f,1),room,field_number(f,3),f.size()>=5?field_number(f,4):-1);
+		out<<room;
+		reply=out.str();
+		return result;
+	}
+	if(cmd=="table" && f.size()>=3)
+	{
+		Table_Reservation r;
+		int slot=f.size()>=4?slot_of(f[3]):current_slot();
+		int result=front_desk.book_table(field_number(f,1),field_number(f,2),slot,r);
+		if(result==DESK_OK)
+			out<<r.table<<" "<<slot_text(r.slot);
+		reply=out.str();
+		return result;
+	}
+	if(cmd=="checkout" && f.size()>=2)
+	{
+		Settlement_Record bill;
+		int result=front_desk.checkout(field_number(f,1),f.size()>=3?field_number(f,2):2,bill);
+		if(result==DESK_OK)
+			out<<bill.total;
+		reply=out.str();
+		return result;
+	}
+	if(cmd=="charge" && f.size()>=3)
+		return front_desk.post_charge(field_number(f,1),field_number(f,2));
+	if(cmd=="quote" && f.size()>=3)
+	{
+		int quotes[ROOM_TYPES],a=day_of(f[1]),nights=field_number(f,2);
+		if(a<0 || nights<=0)
+			return BAD_REQUEST;
+		rate_calendar.quote_all(a,nights,quotes);
+		for(int t=0;t<ROOM_TYPES;t++)
+			out<<(t?" ":"")<<quotes[t];
+		reply=out.str();
+		return DESK_OK;
+	}
+	if(cmd=="report" && f.size()>=3)
+	{
+		Rollup_Totals r;
+		int a=day_of(f[1]),b=day_of(f[2]);
+		if(a<0 || a>b)
+			return BAD_REQUEST;
+		rollups.report(a,b,r);
+		for(int t=0;t<ROOM_TYPES;t++)
+			out<<(t?" ":"")<<r.occupied[t]<<"/"<<(long long)r.rooms[t]*r.days<<":"<<r.revenue[t];
+		reply=out.str();
+		return DESK_OK;
+	}
+	if(cmd=="audit")
+	{
+		Audit_Report report;
+		int day=f.size()>=2?day_of(f[1]):-1;
+		if(f.size()>=2 && day<0)
+			return BAD_REQUEST;
+		int result=night_audit.run(day,report);
+		long long posted=0;
+		for(int t=0;t<ROOM_TYPES;t++)
+			posted+=report.totals.posted[t];
+		if(result==DESK_OK)
+			out<<date_text(report.totals.day)<<" "<<report.totals.postings<<" "<<posted<<" "<<report.totals.overdue<<" "<<fixed<<setprecision(1)<<report.millis;
+		reply=out.str();
+		return result;
+	}
+	if(cmd=="find" && f.size()>=2)
+	{
+		Booking_Record rec;
+		if(!front_desk.find(field_number(f,1),rec))
+			return NO_OPEN_STAY;
+		out<<rec.id<<"|"<<guest_directory.name_of(rec.guest)<<"|"<<rec.days<<"|"<<rec.amount;
+		reply=out.str();
+		return DESK_OK;
+	}
+	return BAD_REQUEST;
+}
+
+//---------------- Batch mode ----------------
+//Replays desk commands from a file or stdin, one per line; lines
+//starting with '#' are skipped. Prints throughput and latency per command.
+class Batch_Runner
+{
+	protected:
+		map<string,vector<double> > latency;		//command -> microseconds per call
+		map<string,int> failed;
+		int lines;
+
+		static double percentile(const vector<double> &sorted,double p)
+		{
+			size_t i=(size_t)(p*(sorted.size()-1)+0.5);
+			return sorted[i];
+		}
+	public:
+		Batch_Runner()
+		{
+			lines=0;
+		}
+		void run(istream &in)
+		{
+			string line;
+			chrono::steady_clock::time_point start=chrono::steady_clock::now();
+			while(getline(in,line))
+			{
+				lines++;
+				if(!line.empty() && line[line.size()-1]=='\r')
+					line.erase(line.size()-1);
+				if(line.empty() || line[0]=='#')
+					continue;
+				vector<string> f=split_command(line);
+				string reply;
+				chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+				int result=run_command(f,reply);
+				chrono::steady_clock::time_point t1=chrono::steady_clock::now();
+				latency[f[0]].push_back(chrono::duration<double,micro>(t1-t0).count());
+				if(result!=DESK_OK)
+				{
+					failed[f[0]]++;
+					cerr<<"line "<<lines<<": "<<f[0]<<": "<<desk_result_text[result]<<endl;
+				}
+			}
+			booking_store.commit();
+			double seconds=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+			report(seconds);
+		}
+		void record(const string &command,double micros,bool ok)
+		{
+			latency[command].push_back(micros);
+			if(!ok)
+				failed[command]++;
+		}
+		void report(double seconds)
+		{
+			size_t total=0;
+			cout<<left<<setw(10)<<"command"<<right<<setw(10)<<"count"<<setw(8)<<"failed"
+				<<setw(12)<<"mean(us)"<<setw(12)<<"p50(us)"<<setw(12)<<"p99(us)"<<setw(12)<<"max(us)"<<endl;
+			for(map<string,vector<double> >::iterator it=latency.begin();it!=latency.end();++it)
+			{
+				vector<double> &v=it->second;
+				sort(v.begin(),v.end());
+				double sum=0;
+				for(size_t i=0;i<v.size();i++)
+					sum+=v[i];
+				total+=v.size();
+				cout<<left<<setw(10)<<it->first<<right<<setw(10)<<v.size()<<setw(8)<<failed[it->first]
+					<<fixed<<setprecision(2)<<setw(12)<<sum/v.size()<<setw(12)<<percentile(v,0.5)
+					<<setw(12)<<percentile(v,0.99)<<setw(12)<<v.back()<<endl;
+			}
+			cout<<total<<" commands in "<<fixed<<setprecision(3)<<seconds<<" s ("
+				<<setprecision(0)<<(seconds>0?total/seconds:0)<<" commands/s)"<<endl;
+		}
+};
+
+//---------------- Desk service ----------------
+//Serves several reception counters at once over a local Unix socket.
+//Each clerk session gets a thread; requests are desk commands and every
+//reply is one line, "OK [details]" or "ERR <reason>".
+#ifndef _WIN32
+class Desk_Service
+{
+	protected:
+		string path;
+
+		static void session(int client)
+		{
+			string buffer,line;
+			char chunk[4096];
+			long got;
+			while((got=recv(client,chunk,sizeof(chunk),0))>0)
+			{
+				buffer.append(chunk,got);
+				size_t newline;
+				while((newline=buffer.find('\n'))!=string::npos)
+				{
+					line=buffer.substr(0,newline);
+					buffer.erase(0,newline+1);
+					if(!line.empty() && line[line.size()-1]=='\r')
+						line.erase(line.size()-1);
+					if(line.empty())
+						continue;
+					string reply,details;
+					int result=run_command(split_command(line),details);
+					reply=result==DESK_OK?"OK":string("ERR ")+desk_result_text[result];
+					if(result==DESK_OK && !details.empty())
+						reply+=" "+details;
+					reply+="\n";
+					if(send(client,reply.data(),reply.size(),0)<0)
+						break;
+				}
+			}
+			::close(client);
+		}
+	public:
+		Desk_Service(const string &socket_path)
+		{
+			path=socket_path;
+		}
+		bool run()
+		{
+			sockaddr_un address;
+			memset(&address,0,sizeof(address));
+			address.sun_family=AF_UNIX;
+			if(path.size()>=sizeof(address.sun_path))
+				return false;
+			strcpy(address.sun_path,path.c_str());
+			int server=socket(AF_UNIX,SOCK_STREAM,0);
+			unlink(path.c_str());
+			if(server<0 || bind(server,(sockaddr*)&address,sizeof(address))<0 || listen(server,16)<0)
+			{
+				cout<<"Can't listen on "<<path<<endl;
+				return false;
+			}
+			cout<<"Front desk service on "<<path<<endl;
+			//A clerk that hangs up before its reply is written must only
+			//end its own session, not the service.
+			signal(SIGPIPE,SIG_IGN);
+			int client;
+			while((client=accept(server,NULL,NULL))>=0)
+				thread(session,client).detach();
+			return true;
+		}
+};
+//A clerk session: sends each stdin line to the service and prints the reply.
+bool desk_client(const string &path)
+{
+	sockaddr_un address;
+	memset(&address,0,sizeof(address));
+	address.sun_family=AF_UNIX;
+	strncpy(address.sun_path,path.c_str(),sizeof(address.sun_path)-1);
+	int server=socket(AF_UNIX,SOCK_STREAM,0);
+	if(server<0 || connect(server,(sockaddr*)&address,sizeof(address))<0)
+	{
+		cout<<"Can't reach the front desk service on "<<path<<endl;
+		return false;
+	}
+	string line;
+	while(getline(cin,line))
+	{
+		line+="\n";
+		if(send(server,line.data(),line.size(),0)<0)
+			break;
+		string reply;
+		char c;
+		while(recv(server,&c,1,0)==1 && c!='\n')
+			reply+=c;
+		cout<<reply<<endl;
+	}
+	::close(server);
+	return true;
+}
+#endif
+
+//---------------- Tariff microbenchmark ----------------
+//The old set_1/set_a/set_b dispatch: nested runtime switches with the
+//tariff hard-coded in each routine and 1500 always persisted.
+int legacy_folio(int ch,int chh,int n,int &persisted)
+{
+	int shown=0;
+	switch(ch)
+	{
+		case 1:
+			switch(chh)
+			{
+				case 1: shown=n*900; break;
+				case 2: shown=n*500; break;
+			}
+			break;
+		case 2:
+			switch(chh)
+			{
+				case 1: shown=n*1500; break;
+				case 2: shown=n*1000; break;
+			}
+			break;
+	}
+	persisted=n*1500;
+	return shown;
+}
+template<class Room,class Bed> long long policy_folios(const vector<int> &nights)
+{
+	long long sum=0;
+	for(size_t i=0;i<nights.size();i++)
+		sum+=Tariff<Room,Bed>::folio(nights[i]);
+	return sum;
+}
+void bench_tariff(int count)
+{
+	vector<int> ch(count),chh(count),nights(count);
+	srand(7);
+	for(int i=0;i<count;i++)
+	{
+		ch[i]=1+rand()%2;
+		chh[i]=1+rand()%2;
+		nights[i]=1+rand()%14;
+	}
+	long long sum=0;
+	int persisted;
+	chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+	for(int i=0;i<count;i++)
+		sum+=legacy_folio(ch[i],chh[i],nights[i],persisted)+persisted;
+	chrono::steady_clock::time_point t1=chrono::steady_clock::now();
+	for(int i=0;i<count;i++)
+		sum+=2*room_tariff[chh[i]-1][2-ch[i]]*nights[i];
+	chrono::steady_clock::time_point t2=chrono::steady_clock::now();
+	sum+=2*policy_folios<Ac_Room,Single_Bed>(nights);
+	chrono::steady_clock::time_point t3=chrono::steady_clock::now();
+	int quotes[ROOM_TYPES];
+	for(int i=0;i<count;i++)
+	{
+		rate_calendar.quote_all(today()+i%365,nights[i],quotes);
+		sum+=quotes[chh[i]-1];
+	}
+	chrono::steady_clock::time_point t4=chrono::steady_clock::now();
+	int year=count/1000>0?count/1000:1;
+	for(int i=0;i<year;i++)
+	{
+		rate_calendar.quote_all(today()+i%365,365,quotes);
+		sum+=quotes[i%ROOM_TYPES];
+	}
+	chrono::steady_clock::time_point t5=chrono::steady_clock::now();
+	double legacy=chrono::duration<double,nano>(t1-t0).count()/count;
+	double table=chrono::duration<double,nano>(t2-t1).count()/count;
+	double policy=chrono::duration<double,nano>(t3-t2).count()/count;
+	double calendar=chrono::duration<double,nano>(t4-t3).count()/count;
+	double long_stay=chrono::duration<double,nano>(t5-t4).count()/year;
+	cout<<count<<" folios (checksum "<<sum<<")"<<endl;
+	cout<<fixed<<setprecision(3);
+	cout<<"legacy switches      "<<legacy<<" ns/booking"<<endl;
+	cout<<"constexpr table      "<<table<<" ns/booking"<<endl;
+	cout<<"specialized policy   "<<policy<<" ns/booking"<<endl;
+	cout<<"rate calendar        "<<calendar<<" ns/quote of all "<<ROOM_TYPES<<" room types"<<endl;
+	cout<<"rate calendar, 1 yr  "<<long_stay<<" ns/quote of all "<<ROOM_TYPES<<" room types"<<endl;
+}
+
+//---------------- Table benchmark ----------------
+//Peak dinner load: a 200-table restaurant taking 1000 walk-ins and
+//bookings for 18:00-22:30 each evening, without persistence.
+void bench_tables(int count)
+{
+	Table_Book book;
+	vector<pair<int,int> > tables;
+	for(int t=1;t<=200;t++)
+		tables.push_back(make_pair(2+2*(t%4),t));
+	book.set_tables(tables);
+	srand(11);
+	vector<double> reserve_ns,query_ns;
+	int booked=0;
+	long long offered=0;
+	Table_Reservation r;
+	chrono::steady_clock::time_point start=chrono::steady_clock::now();
+	for(int i=0;i<count;i++)
+	{
+		int party=1+rand()%8,day=i/1000,slot=36+rand()%10;
+		chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+		offered+=book.free_tables(party,day,slot);
+		chrono::steady_clock::time_point t1=chrono::steady_clock::now();
+		if(book.reserve(party,0,day,slot,r)==DESK_OK)
+			booked++;
+		chrono::steady_clock::time_point t2=chrono::steady_clock::now();
+		query_ns.push_back(chrono::duration<double,nano>(t1-t0).count());
+		reserve_ns.push_back(chrono::duration<double,nano>(t2-t1).count());
+	}
+	double seconds=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+	sort(reserve_ns.begin(),reserve_ns.end());
+	sort(query_ns.begin(),query_ns.end());
+	cout<<count<<" requests, "<<booked<<" seated, "<<offered<<" tables offered, "<<fixed<<setprecision(0)<<count/seconds<<" requests/s"<<endl;
+	cout<<setprecision(1);
+	cout<<"reserve   p50 "<<reserve_ns[count/2]<<" ns  p99 "<<reserve_ns[count*99/100]<<" ns"<<endl;
+	cout<<"free      p50 "<<query_ns[count/2]<<" ns  p99 "<<query_ns[count*99/100]<<" ns"<<endl;
+}
+
+//Night audit over a full house of synthetic rooms, 99 to a floor, on
+//one thread and then on the whole pool; nothing is written.
+void bench_audit(int rooms)
+{
+	vector<Booking_Record> stays(rooms);
+	for(int i=0;i<rooms;i++)
+	{
+		Booking_Record &s=stays[i];
+		memset(&s,0,sizeof(s));
+		s.id=i+1;
+		s.room=(i/99+1)*100+i%99+1;
+		s.check_in=today()-i%5;
+		s.days=1+i%7;
+		s.status=BOOKED;
+		room_calendar.add_room(s.room,(i/99)%ROOM_TYPES);
+	}
+	Audit_Report report;
+	vector<Night_Posting> postings;
+	int threads=max(1u,thread::hardware_concurrency());
+	for(int pass=0;pass<(threads>1?2:1);pass++)
+	{
+		night_audit.set_workers(pass?threads:1);
+		double best=0;
+		for(int round=0;round<5;round++)
+		{
+			night_audit.audit(stays,today(),report,postings);
+			best=round?min(best,report.millis):report.millis;
+		}
+		cout<<rooms<<" rooms, "<<(pass?threads:1)<<" thread(s): "<<postings.size()<<" postings, "<<report.totals.overdue
+			<<" overdue, best of 5 "<<fixed<<setprecision(2)<<best<<" ms"<<endl;
+	}
+}
+
+void close_store()
+{
+	journal_queue.stop();
+	booking_store.close();
+	table_book.close();
+	folio_ledger.close();
+	guest_directory.close();
+	rollups.close();
+	night_audit.close();
+}
+
+//Drives the front desk with synthetic guests at growing history sizes:
+//the store is filled with checked-out stays up to each size, then every
+//desk operation is timed for a round of arrivals on bench-*.dat files.
+const char *bench_files[]={"bench.dat","bench-guests.dat","bench-tables.dat","bench-settle.dat","bench-rollup.dat","bench.dat.snap"};
+const int BENCH_FILES=sizeof(bench_files)/sizeof(bench_files[0]);
+
+void bench_desk(int max_records)
+{
+	for(int f=0;f<BENCH_FILES;f++)
+		remove(bench_files[f]);
+	if(!guest_directory.open(bench_files[1]) || !booking_store.open(bench_files[0],""))
+		return;
+	booking_store.set_durability(Journal_Writer::EVERY_N_RECORDS,4096);
+	guest_directory.set_durability(Journal_Writer::EVERY_N_RECORDS,4096);
+	room_calendar.load_rooms("");
+	table_book.load_tables("");
+	if(!table_book.open(bench_files[2]) || !folio_ledger.open(bench_files[3]) || !rollups.open(bench_files[4]))
+		return;
+	rollups.set_durability(Journal_Writer::EVERY_N_RECORDS,4096);
+	vector<int> rooms;
+	for(int t=0;t<ROOM_TYPES;t++)
+	{
+		vector<int> free=room_calendar.free_rooms(t,today(),today()+1);
+		rooms.insert(rooms.end(),free.begin(),free.end());
+	}
+	vector<int> guests;
+	for(int g=0;g<1000;g++)
+	{
+		ostringstream mobile;
+		mobile<<9000000000LL+g;
+		guests.push_back(guest_directory.register_guest(mobile.str(),"Guest "+mobile.str(),"","Bench","M"));
+	}
+	const int sizes[]={1000,100000,10000000};
+	const int ROUNDS=1000;
+	srand(7);
+	Booking_Viewer viewer(bench_files[0]);
+	for(int level=0;level<3 && (level==0 || sizes[level-1]<max_records);level++)
+	{
+		int target=min(sizes[level],max_records);
+		Booking_Record rec;
+		memset(&rec,0,sizeof(rec));
+		while(booking_store.size()<target)
+		{
+			rec.room=rooms[rand()%rooms.size()];
+			rec.days=1+rand()%5;
+			rec.check_in=today()-rand()%3650;
+			rec.rate=nightly_tariff(room_calendar.type_of(rec.room));
+			rec.amount=rec.days*rec.rate;
+			rec.pay_mode=1+rand()%2;
+			rec.status=CHECKED_OUT;
+			rec.guest=guests[rand()%guests.size()];
+			booking_store.add(rec);
+		}
+		booking_store.commit();
+		cout<<"--- "<<booking_store.size()<<" records ---"<<endl;
+		Batch_Runner stats;
+		chrono::steady_clock::time_point start=chrono::steady_clock::now();
+		for(int i=0;i<ROUNDS;i++)
+		{
+			int a=rooms[i%rooms.size()],b=rooms[(i+rooms.size()/2)%rooms.size()];
+			Booking_Record stay;
+			Table_Reservation r;
+			Settlement_Record bill;
+			vector<const Booking_Record*> page;
+			Booking_Filter filter;
+			memset(&stay,0,sizeof(stay));
+			stay.room=a;
+			stay.days=1+rand()%5;
+			stay.pay_mode=1;
+			stay.guest=guests[rand()%guests.size()];
+			chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+			int booked=front_desk.book(stay,-1);
+			chrono::steady_clock::time_point t1=chrono::steady_clock::now();
+			int changed=front_desk.change_room(a,b,stay.days);
+			chrono::steady_clock::time_point t2=chrono::steady_clock::now();
+			int seated=front_desk.book_table(1+rand()%8,0,36+rand()%10,r);
+			chrono::steady_clock::time_point t3=chrono::steady_clock::now();
+			int settled=front_desk.checkout(changed==DESK_OK?b:a,1,bill);
+			chrono::steady_clock::time_point t4=chrono::steady_clock::now();
+			filter.room=b;
+			viewer.page(filter,0,10,page);
+			chrono::steady_clock::time_point t5=chrono::steady_clock::now();
+			if(seated==DESK_OK)
+				table_book.cancel(r.id);
+			stats.record("book",chrono::duration<double,micro>(t1-t0).count(),booked==DESK_OK);
+			stats.record("change",chrono::duration<double,micro>(t2-t1).count(),changed==DESK_OK);
+			stats.record("table",chrono::duration<double,micro>(t3-t2).count(),seated==DESK_OK);
+			stats.record("checkout",chrono::duration<double,micro>(t4-t3).count(),settled==DESK_OK);
+			stats.record("list",chrono::duration<double,micro>(t5-t4).count(),!page.empty());
+		}
+		booking_store.commit();
+		stats.report(chrono::duration<double>(chrono::steady_clock::now()-start).count());
+	}
+	close_store();
+	for(int f=0;f<BENCH_FILES;f++)
+		remove(bench_files[f]);
+}
+//--durability record | <N>ms | <N> (records per group commit)
+bool parse_durability(const string &value)
+{
+	int n=atoi(value.c_str());
+	Journal_Writer::Durability how;
+	if(value=="record")
+		how=Journal_Writer::PER_RECORD;
+	else if(n>0 && value.find("ms")!=string::npos)
+		how=Journal_Writer::EVERY_N_MS;
+	else if(n>0)
+		how=Journal_Writer::EVERY_N_RECORDS;
+	else
+		return false;
+	booking_store.set_durability(how,n);
+	guest_directory.set_durability(how,n);
+	rollups.set_durability(how,n);
+	return true;
+}
+  int main(int argc,char *argv[])
+  {		
+	const char *batch=NULL,*serve=NULL;
+	int audit=-2;		//--audit: night to close, -1 the business date
+	for(int i=1;i<argc;i++)
+	{
+		string arg=argv[i];
+		if(arg=="--durability" && i+1<argc && parse_durability(argv[i+1]))
+			i++;
+		else if(arg=="--allocate" && i+1<argc && (string(argv[i+1])=="fill" || string(argv[i+1])=="spread"))
+			room_calendar.set_policy(string(argv[++i])=="fill"?Room_Calendar::FILL_FLOOR:Room_Calendar::SPREAD);
+		else if(arg=="--stats" && i+1<argc)
+			stats_path=argv[++i];
+		else if(arg=="--batch" && i+1<argc)
+			batch=argv[++i];
+#ifndef _WIN32
+		else if(arg=="--serve" && i+1<argc)
+			serve=argv[++i];
+		else if(arg=="--desk" && i+1<argc)
+			return desk_client(argv[i+1])?0:1;
+#endif
+		else if(arg=="--audit")
+		{
+			audit=i+1<argc && day_of(argv[i+1])>=0?day_of(argv[++i]):-1;
+		}
+		else if(arg=="--bench-audit")
+		{
+			int rooms=i+1<argc?atoi(argv[i+1]):10000;
+			bench_audit(rooms>0?rooms:10000);
+			return 0;
+		}
+		else if(arg=="--bench-tables")
+		{
+			int count=i+1<argc?atoi(argv[i+1]):1000000;
+			bench_tables(count>0?count:1000000);
+			return 0;
+		}
+		else if(arg=="--bench")
+		{
+			int count=i+1<argc?atoi(argv[i+1]):10000000;
+			bench_desk(count>0?count:10000000);
+			return 0;
+		}
+		else if(arg=="--bench-tariff")
+		{
+			bench_tariff(i+1<argc?atoi(argv[i+1]):10000000);
+			return 0;
+		}
+		else
+		{
+			cout<<"usage: "<<argv[0]<<" [--durability record|<N>ms|<N>] [--allocate fill|spread] [--stats <file>] [--batch <file>|-] [--bench [records]] [--bench-tariff [count]] [--bench-tables [count]] [--audit [YYYY-MM-DD]] [--bench-audit [rooms]] [--serve <socket>] [--desk <socket>]"<<endl;
+			return 1;
+		}
+	}
+	if(!guest_directory.open("guests.dat") || !booking_store.open("1.dat","1.txt"))
+		return 1;
+	load_calendar();
+	table_book.load_tables("tables.txt");
+	rate_calendar.load_rates("rates.txt");
+	if(!table_book.open("tables.dat") || !folio_ledger.open("settle.dat") || !rollups.open("rollup.dat") || !night_audit.open("audit.dat"))
+		return 1;
+	atexit(close_store);
+	if(audit!=-2)
+	{
+		Audit_Report report;
+		if(night_audit.run(audit,report)!=DESK_OK)
+		{
+			cout<<"Night already audited or not over yet; business date "<<date_text(night_audit.business_date())<<endl;
+			return 1;
+		}
+		print_audit(report);
+		return 0;
+	}
+#ifndef _WIN32
+	if(serve)
+		return Desk_Service(serve).run()?0:1;
+#endif
+	if(batch)
+	{
+		Batch_Runner runner;
+		if(string(batch)=="-")
+			runner.run(cin);
+		else
+		{
+			ifstream in(batch);
+			if(!in)
+			{
+				cout<<"Can't open "<<batch<<endl;
+				return 1;
+			}
+			runner.run(in);
+		}
+		return 0;
+	}
+	author object1;
+  	return 0;
+  }